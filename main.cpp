@@ -3,10 +3,16 @@
 #include <bit>
 #include <chrono>
 #include <climits>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <memory>
 #include <optional>
+#include <random>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -209,18 +215,56 @@ void testPrimitiveConversions() {
            "deserialize double (negative)");
     assertEqual(NaN, str::deserializePrimitive<double>("forty-two"), "deserialize double (invalid)");
 
+    // Test correct rounding, special values and strictness of float parsing
+    assertEqual(0.1, str::deserializePrimitive<double>("0.1"), "deserialize double (rounding)");
+    assertEqual(2.2250738585072011e-308, str::deserializePrimitive<double>("2.2250738585072011e-308"),
+                "deserialize double (smallest normal)");
+    assertEqual(9007199254740992.0, str::deserializePrimitive<double>("9007199254740993"),
+                "deserialize double (halfway to even)");
+    assertEqual(1.0F, str::deserializePrimitive<float>("1.000000059604644775390625"), "deserialize float (halfway)");
+    assertEqual(1.00000012F, str::deserializePrimitive<float>("1.000000059604644775390626"),
+                "deserialize float (above halfway)");
+    assert(std::isnan(str::deserializePrimitive<float>("-nan").value_or(0)), "deserialize float (nan)");
+    assertEqual(-INFINITY, str::deserializePrimitive<double>("-inf"), "deserialize double (inf)");
+    assertEqual(NaN, str::deserializePrimitive<float>("1e50"), "deserialize float (overflow)");
+    assertEqual(NaN, str::deserializePrimitive<double>("1.5x"), "deserialize double (trailing characters)");
+    assertEqual(NaN, str::deserializePrimitive<double>(" 1.5"), "deserialize double (leading whitespace)");
+
+    // Test shortest representations of random doubles round trip exactly
+    std::mt19937_64 random(42);
+    std::size_t mismatches = 0;
+    for(std::size_t i = 0; i < 10000; i++) {
+        const auto value = std::bit_cast<double>(random());
+        if(!std::isfinite(value)) continue;
+        std::array<char, 32> buffer{};
+        const auto [end, _] = std::to_chars(buffer.begin(), buffer.end(), value);
+        if(str::deserializePrimitive<double>(std::string(buffer.begin(), end)) != value) mismatches++;
+    }
+    assertEqual(std::size_t{ 0 }, mismatches, "deserialize double (random round trip)");
+
     // Test str::serializePrimitive(string)
     assertEqual("\"Hello, world!\"", str::serializePrimitive<std::string>("Hello, world!"),
                 "serialize string (simple)");
-    assertEqual("\"&quot;Hello!&quot;&newline;\"", str::serializePrimitive<std::string>("\"Hello!\"\n"),
+    assertEqual("\"\\\"Hello!\\\"\\n\\\\\"", str::serializePrimitive<std::string>("\"Hello!\"\n\\"),
                 "serialize string (complex)");
 
     // Test str::deserializePrimitive<string>()
     assertEqual("Hello, world!", str::deserializePrimitive<std::string>("\"Hello, world!\""),
                 "deserialize string (simple)");
-    assertEqual("\"Hello!\"\n", str::deserializePrimitive<std::string>("\"&quot;Hello!&quot;&newline;\""),
+    assertEqual("\"Hello!\"\n\\", str::deserializePrimitive<std::string>("\"\\\"Hello!\\\"\\n\\\\\""),
                 "deserialize string (complex)");
+    assertEqual("&quot;", str::deserializePrimitive<std::string>("\"&quot;\""), "deserialize string (entity)");
     assertEqual(NaN, str::deserializePrimitive<std::string>("123"), "deserialize string (invalid)");
+    for(const std::string invalid : { "\"", "\"a\"b\"", "\"a\\\"", "\"a\\t\"" })
+        assertEqual(NaN, str::deserializePrimitive<std::string>(invalid), "deserialize string (invalid escape)");
+    for(const std::string value : { "", "\\", "\\n", "\"\"", "a\\\"b\n\\", "&quot;&newline;" }) {
+        assertEqual(value, str::deserializePrimitive<std::string>(str::serializePrimitive(value)),
+                    "string (round trip)");
+    }
+
+    // Test str::deserializeLegacyString() (text without version)
+    assertEqual("\"Hello!\"\n", str::deserializeLegacyString("\"&quot;Hello!&quot;&newline;\""),
+                "deserialize legacy string");
 
     // Test str::serializePrimitive(Enum)
     assertEqual("1", str::serializePrimitive<Enum>(Enum::DEF), "serialize Enum (DEF)");
@@ -296,6 +340,195 @@ void testParsers() {
         assertEqual("my_pointer", pointer->at(1), "parsePointer 1 (name)");
         assertEqual("42", pointer->at(2), "parsePointer 1 (address)");
     } else assert(false, "parsePointer 1");
+
+    // Test compact data
+    primitive = str::parsePrimitive("STRING my string=\"a = b\"");
+    if(primitive) {
+        assertEqual("my string", primitive->at(1), "parsePrimitive compact (name)");
+        assertEqual("\"a = b\"", primitive->at(2), "parsePrimitive compact (value)");
+    } else assert(false, "parsePrimitive compact");
+
+    object = str::parseObject("OBJECT<0> root = 1 { INT answer = 42; FLOAT PI = 3.14159 }");
+    if(object) assertEqual("INT answer = 42; FLOAT PI = 3.14159", object->at(3), "parseObject inline (children)");
+    else assert(false, "parseObject inline");
+
+    object = str::parseObject("OBJECT<0> root=1{INT answer=42;FLOAT PI=3.14159}");
+    if(object) assertEqual("INT answer=42;FLOAT PI=3.14159", object->at(3), "parseObject compact inline (children)");
+    else assert(false, "parseObject compact inline");
+
+    object = str::parseObject("OBJECT<0> root=1{\nINT answer=42\n}");
+    if(object) {
+        assertEqual("root", object->at(1), "parseObject compact (name)");
+        assertEqual("1", object->at(2), "parseObject compact (address)");
+        assertEqual("INT answer=42", object->at(3), "parseObject compact (children)");
+    } else assert(false, "parseObject compact");
+
+    pointer = str::parsePointer("PTR<8> my_pointer=42");
+    if(pointer) {
+        assertEqual("my_pointer", pointer->at(1), "parsePointer compact (name)");
+        assertEqual("42", pointer->at(2), "parsePointer compact (address)");
+    } else assert(false, "parsePointer compact");
+}
+
+void testPacking() {
+    namespace str  = serializable::detail::string;
+    namespace pack = serializable::detail::packing;
+
+    // Test str::encodeBase64 and str::decodeBase64
+    const std::vector<unsigned char> bytes = { 0x00, 0x10, 0x83, 0xFF, 0x7E };
+    assertEqual("ABCD/34", str::encodeBase64(bytes), "str::encodeBase64");
+    assertEqual(bytes, str::decodeBase64("ABCD/34").value_or(std::vector<unsigned char>{}), "str::decodeBase64");
+    assert(!str::decodeBase64("AB CD"), "str::decodeBase64 (invalid)");
+
+    // Test str::isUTF8 (invalid bytes are placed behind a full ASCII block)
+    const std::string ascii = "0123456789abcdefXYZ";
+    assert(str::isUTF8(""), "str::isUTF8 (empty)");
+    assert(str::isUTF8(ascii), "str::isUTF8 (ASCII)");
+    assert(str::isUTF8(ascii + "\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80" + ascii), "str::isUTF8 (multi-byte)");
+    assert(str::isUTF8("\xED\x9F\xBF\xF4\x8F\xBF\xBF"), "str::isUTF8 (limits)");
+    for(const std::string invalid : { "\x80", "\xC0\x80", "\xC3", "\xE0\x9F\x80", "\xED\xA0\x80",
+                                      "\xF0\x8F\x80\x80", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80",
+                                      "\xE2\x82", "\xE2\x28\xAC" }) {
+        assert(!str::isUTF8(invalid), "str::isUTF8 (invalid)");
+        assert(!str::isUTF8(ascii + invalid + ascii), "str::isUTF8 (invalid after ASCII)");
+    }
+
+    // Test pack::prefixSum
+    std::vector<pack::Word> words = { 1, 2, 3, 4, 5, 6, 7 };
+    pack::prefixSum(words);
+    assertEqual(std::vector<pack::Word>{ 1, 3, 6, 10, 15, 21, 28 }, words, "pack::prefixSum");
+
+    // Test pack::encodeDelta and pack::decodeDelta
+    const std::vector<long> timestamps = { 1000, 1010, 1020, 1015, LONG_MIN, LONG_MAX };
+    assertEqual("6 1000 10 10 -5 9223372036854774793 -1", pack::encodeDelta(timestamps), "pack::encodeDelta");
+    assertEqual(timestamps, pack::decodeDelta<long>(pack::encodeDelta(timestamps)).value_or(std::vector<long>{}),
+                "pack::decodeDelta");
+    assert(!pack::decodeDelta<long>("3 1 2"), "pack::decodeDelta (count mismatch)");
+    assert(!pack::decodeDelta<unsigned char>("1 256"), "pack::decodeDelta (overflow)");
+
+    // Test pack::encodeDeltaOfDelta and pack::decodeDeltaOfDelta
+    const std::list<unsigned int> ticks = { 100, 110, 120, 130, 141, 150 };
+    assertEqual("6 100 10 0 0 1 -2", pack::encodeDeltaOfDelta(ticks), "pack::encodeDeltaOfDelta");
+    const auto decodedTicks = pack::decodeDeltaOfDelta<unsigned int>(pack::encodeDeltaOfDelta(ticks));
+    assertEqual(std::vector<unsigned int>(ticks.begin(), ticks.end()),
+                decodedTicks.value_or(std::vector<unsigned int>{}), "pack::decodeDeltaOfDelta");
+
+    // Test pack::encodeFrameOfReference and pack::decodeFrameOfReference
+    const std::array<short, 5> ids = { -3, 4, 0, -1, 2 };
+    assertEqual("5 -3 3 +FQ", pack::encodeFrameOfReference(ids), "pack::encodeFrameOfReference");
+    const auto decodedIds = pack::decodeFrameOfReference<short>(pack::encodeFrameOfReference(ids));
+    assertEqual(std::vector<short>(ids.begin(), ids.end()), decodedIds.value_or(std::vector<short>{}),
+                "pack::decodeFrameOfReference");
+    assertEqual("0 0 0 ", pack::encodeFrameOfReference(std::vector<int>{}), "pack::encodeFrameOfReference (empty)");
+    assert(pack::decodeFrameOfReference<int>("0 0 0 ").has_value(), "pack::decodeFrameOfReference (empty)");
+    assert(!pack::decodeFrameOfReference<int>("5 -3 3 +F"), "pack::decodeFrameOfReference (truncated)");
+    assert(!pack::decodeFrameOfReference<int>("1000000000000000 7 0 "), "pack::decodeFrameOfReference (no bits)");
+    assert(!pack::decodeFrameOfReference<int>("4611686018427387904 0 4 "), "pack::decodeFrameOfReference (overflow)");
+
+    // Test pack::encodeRunLength and pack::decodeRunLength
+    const std::vector<int> runs = { 0, 0, 0, 7, 7, 0 };
+    assertEqual("6 0 3 7 2 0 1", pack::encodeRunLength(runs), "pack::encodeRunLength");
+    assertEqual(runs, pack::decodeRunLength<int>("6 0 3 7 2 0 1").value_or(std::vector<int>{}),
+                "pack::decodeRunLength");
+    assertEqual("0", pack::encodeRunLength(std::vector<int>{}), "pack::encodeRunLength (empty)");
+    assert(!pack::decodeRunLength<int>("5 0 3 7 3"), "pack::decodeRunLength (too long)");
+    assert(!pack::decodeRunLength<int>("6 0 3 7 2"), "pack::decodeRunLength (too short)");
+    assert(!pack::decodeRunLength<char>("1 300 1"), "pack::decodeRunLength (out of range)");
+    assert(!pack::decodeRunLength<int>("1000000000000000 0 1000000000000000"), "pack::decodeRunLength (too many)");
+    assert(!pack::decodeRunLength<double>("67108864 0 67108864"), "pack::decodeRunLength (beyond data)");
+    assert(!pack::decodeRunLength<int>("5 0 5", 4), "pack::decodeRunLength (beyond maximum)");
+
+    // Test pack::encodeSparse and pack::decodeSparse (floats are compared bitwise and written exactly)
+    const std::vector<float> sparse = { 0, 0, 0.1F, 0, 0, 0, -0.0F, 0 };
+    assertEqual("8 0 2 0.1 4 -0", pack::encodeSparse(sparse), "pack::encodeSparse");
+    const auto unpacked = pack::decodeSparse<float>("8 0 2 0.1 4 -0").value_or(std::vector<float>{});
+    assertEqual(sparse, unpacked, "pack::decodeSparse");
+    assert(unpacked.size() == 8 && std::signbit(unpacked[6]), "pack::decodeSparse (negative zero)");
+    assertEqual("3 5", pack::encodeSparse(std::vector<long>{ 5, 5, 5 }), "pack::encodeSparse (dense)");
+    assert(!pack::decodeSparse<int>("3 0 3 1"), "pack::decodeSparse (out of bounds)");
+    assert(!pack::decodeSparse<int>("3 0 1 1 0 2"), "pack::decodeSparse (repeated index)");
+    assert(!pack::decodeSparse<int>("1000000000000000 0"), "pack::decodeSparse (too many)");
+    assert(!pack::decodeSparse<double>("67108864 0", 6), "pack::decodeSparse (beyond maximum)");
+
+    // Test pack::quantize and pack::dequantize (clamped to the bit width, NaN to its minimum, vector and scalar part)
+    const std::vector<float> reals = { 0.1F, -0.25F, 1, 100, -100, 0.125F, 0.135F, NAN, 0.5F };
+    std::vector<std::int32_t> codes(reals.size());
+    pack::quantize(std::span(reals), 0.01, 8, std::span(codes));
+    assertEqual(std::vector<std::int32_t>{ 10, -25, 100, 127, -128, 12, 14, -128, 50 }, codes, "pack::quantize");
+    std::vector<float> dequantized(codes.size());
+    pack::dequantize(std::span<const std::int32_t>(codes), 0.5, std::span(dequantized));
+    assertEqual(std::vector<float>{ 5, -12.5F, 50, 63.5F, -64, 6, 7, -64, 25 }, dequantized, "pack::dequantize");
+
+    // Test pack::toHalf and pack::fromHalf (rounding to nearest even, subnormals, overflow and NaN)
+    assertEqual(std::uint16_t{ 0x3C00 }, pack::toHalf(1.0F), "pack::toHalf");
+    assertEqual(std::uint16_t{ 0xC000 }, pack::toHalf(-2.0F), "pack::toHalf (negative)");
+    assertEqual(std::uint16_t{ 0x7BFF }, pack::toHalf(65504.0F), "pack::toHalf (maximum)");
+    assertEqual(std::uint16_t{ 0x7C00 }, pack::toHalf(65520.0F), "pack::toHalf (overflow)");
+    assertEqual(std::uint16_t{ 0x3C00 }, pack::toHalf(1 + std::ldexp(1.0F, -11)), "pack::toHalf (tie to even)");
+    assertEqual(std::uint16_t{ 0x3C02 }, pack::toHalf(1 + 3 * std::ldexp(1.0F, -11)), "pack::toHalf (tie up)");
+    assertEqual(std::uint16_t{ 0x0001 }, pack::toHalf(std::ldexp(1.0F, -24)), "pack::toHalf (subnormal)");
+    assertEqual(std::uint16_t{ 0x0000 }, pack::toHalf(std::ldexp(1.0F, -25)), "pack::toHalf (underflow)");
+    assertEqual(std::uint16_t{ 0x8000 }, pack::toHalf(-1e-10F), "pack::toHalf (negative underflow)");
+    assertEqual(std::uint16_t{ 0x7E00 }, pack::toHalf(NAN), "pack::toHalf (NaN)");
+    assertEqual(std::ldexp(1.0F, -24), pack::fromHalf(0x0001), "pack::fromHalf (subnormal)");
+    assertEqual(65504.0F, pack::fromHalf(0x7BFF), "pack::fromHalf (maximum)");
+    assertEqual(-INFINITY, pack::fromHalf(0xFC00), "pack::fromHalf (infinity)");
+    assert(std::isnan(pack::fromHalf(0x7E00)), "pack::fromHalf (NaN)");
+
+    // Test pack::encodeFixed, pack::decodeFixed, pack::encodeHalf and pack::decodeHalf
+    const std::vector<double> measured = { 0.1, 1, -2.6, 0.3, 7 };
+    const std::string fixed = pack::encodeFixed(std::span(measured), 0.25, 16);
+    assertEqual("0.25 5 -10 6 ", fixed.substr(0, 13), "pack::encodeFixed");
+    assertEqual(std::vector<double>{ 0, 1, -2.5, 0.25, 7 },
+                pack::decodeFixed<double>(fixed).value_or(std::vector<double>{}), "pack::decodeFixed");
+    assert(!pack::decodeFixed<double>("0 5 -10 6 AAAA"), "pack::decodeFixed (invalid scale)");
+    const std::vector<float> halves = { 1, 7.5F };
+    assertEqual("2 ADyARw", pack::encodeHalf(std::span(halves)), "pack::encodeHalf");
+    assertEqual(halves, pack::decodeHalf<float>("2 ADyARw").value_or(std::vector<float>{}), "pack::decodeHalf");
+    assert(!pack::decodeHalf<float>("3 ADy8Rw"), "pack::decodeHalf (truncated)");
+
+    // Test pack::isEightDigits and pack::parseEightDigits
+    std::uint64_t chunk = 0;
+    std::memcpy(&chunk, "12345678", sizeof(chunk));
+    assert(pack::isEightDigits(chunk), "pack::isEightDigits");
+    if constexpr(std::endian::native == std::endian::little)
+        assertEqual(std::uint64_t{ 12345678 }, pack::parseEightDigits(chunk), "pack::parseEightDigits");
+    std::memcpy(&chunk, "1234/678", sizeof(chunk));
+    assert(!pack::isEightDigits(chunk), "pack::isEightDigits (invalid)");
+
+    // Test pack::parseInteger against std::from_chars on random input (digit runs, signs, overflows and garbage)
+    std::mt19937 random(42);
+    std::size_t mismatches = 0;
+    const auto compare     = [&mismatches]<typename I>(const std::string& input, I initial) {
+        I expected = initial, actual = initial;
+        const auto [expectedEnd, expectedError] = std::from_chars(input.data(), input.data() + input.size(), expected);
+        const auto [actualEnd, actualError]     = pack::parseInteger(input, actual);
+        if(expectedEnd != actualEnd || expectedError != actualError || expected != actual) mismatches++;
+    };
+    for(std::size_t i = 0; i < 20000; i++) {
+        std::string input = random() % 3 == 0 ? "-" : "";
+        if(random() % 4 == 0) input.append(random() % 4, '0');
+        for(std::size_t digits = random() % 26; digits > 0; digits--)
+            input.push_back(static_cast<char>('0' + random() % 10));
+        if(random() % 3 == 0) input.push_back(" -+a/:"[random() % 6]); // NOLINT(*-pointer-arithmetic)
+        if(random() % 2 == 0) input.append(std::to_string(random()));
+
+        compare(input, std::int64_t{ 7 });
+        compare(input, std::uint64_t{ 7 });
+        compare(input, int{ 7 });
+        compare(input, static_cast<unsigned short>(7));
+        compare(input, static_cast<signed char>(7));
+    }
+    for(const std::string limit : { "-128", "-129", "127", "128", "65535", "65536", "-2147483648", "2147483648",
+                                    "-9223372036854775808", "-9223372036854775809", "18446744073709551615",
+                                    "18446744073709551616", "", "-", "00000000000000000000042" }) {
+        compare(limit, std::int64_t{ 7 });
+        compare(limit, std::uint64_t{ 7 });
+        compare(limit, int{ 7 });
+        compare(limit, static_cast<unsigned short>(7));
+        compare(limit, static_cast<signed char>(7));
+    }
+    assertEqual(std::size_t{ 0 }, mismatches, "pack::parseInteger (random)");
 }
 
 // Serial types
@@ -355,6 +588,22 @@ void testSerialObject() {
         if(sub) assertEqual("INT y = 4", sub.value()->get(), "SerialObject::getChild() (pos.y)");
         else assert(false, "SerialObject::getChild() (pos.y)");
     } else assert(false, "SerialObject::getChild() (pos)");
+
+    // Inline objects (only objects of primitives without separators are written on a single line)
+    const std::string inlined = source.get(false, true);
+    assert(inlined.find("OBJECT<1> pos = 0 { INT ") != std::string::npos, "SerialObject::get() (inline)");
+    assert(inlined.starts_with("OBJECT<0> root = 0 {\n"), "SerialObject::get() (inline parent)");
+    SerialObject inlineTarget;
+    assert(inlineTarget.set(inlined), "SerialObject::set() (inline)");
+    const auto inlineChild = inlineTarget.getChild("pos");
+    const auto inlineSub   = inlineChild ? inlineChild.value()->asObject()->getChild("y") : std::nullopt;
+    if(inlineSub) assertEqual("INT y = 4", inlineSub.value()->get(), "SerialObject::set() (inline pos.y)");
+    else assert(false, "SerialObject::set() (inline pos.y)");
+
+    SerialObject separated(0, "root", 0, 0);
+    separated.append(std::make_unique<SerialPrimitive>("STRING", "text", "\"a; b\""));
+    assertEqual("OBJECT<0> root = 0 {\n\tSTRING text = \"a; b\"\n}", separated.get(false, true),
+                "SerialObject::get() (inline separator)");
 }
 
 void testSerialPointer() {
@@ -385,7 +634,7 @@ void testBasic() {
 
     const auto serial = source.serialize();
     assertEqual(Basic::Result::OK, serial.first, "Basic::serialize() (result)");
-    assertEqual("OBJECT<0> root = 0 {\n\tINT value = 42\n}", serial.second, "Basic::serialize() (data)");
+    assertEqual("VERSION 2\nOBJECT<0> root = 0 {\n\tINT value = 42\n}", serial.second, "Basic::serialize() (data)");
 
     Basic target;
     assertEqual(Basic::Result::OK, target.deserialize(serial.second), "Basic::deserialize() (result)");
@@ -497,6 +746,35 @@ void testAllTypes() {
     assertEqual(source.map, target.map, "AllTypes::deserialize() (map)");
     assertEqual(source.umap, target.umap, "AllTypes::deserialize() (umap)");
 
+    // Compact text
+    serializable::Options options;
+    options.compact    = true;
+    const auto compact = source.serialize(options);
+    assertEqual(AllTypes::Result::OK, compact.first, "AllTypes::serialize() (compact result)");
+    assert(compact.second.find('\t') == std::string::npos, "AllTypes::serialize() (compact indentation)");
+    assert(compact.second.find("PTR<1> p=1") != std::string::npos, "AllTypes::serialize() (compact pointer)");
+    assert(compact.second.size() < serial.second.size() * 4 / 5, "AllTypes::serialize() (compact size)");
+
+    AllTypes compactTarget;
+    assertEqual(AllTypes::Result::OK, compactTarget.deserialize(compact.second), "AllTypes::deserialize() (compact)");
+    assertEqual(source.str, compactTarget.str, "AllTypes::deserialize() (compact str)");
+    assertEqual(source.arr, compactTarget.arr, "AllTypes::deserialize() (compact arr)");
+    assertEqual(source.map, compactTarget.map, "AllTypes::deserialize() (compact map)");
+    assertEqual(&compactTarget, compactTarget.p, "AllTypes::deserialize() (compact p)");
+
+    // Inline text (containers of primitives are inlined as well)
+    options.inlining = true;
+    const auto lines = source.serialize(options);
+    AllTypes inlineTarget;
+    assertEqual(AllTypes::Result::OK, lines.first, "AllTypes::serialize() (inline result)");
+    assert(lines.second.size() < compact.second.size(), "AllTypes::serialize() (inline size)");
+    assertEqual(AllTypes::Result::OK, inlineTarget.deserialize(lines.second), "AllTypes::deserialize() (inline)");
+    assertEqual(source.str, inlineTarget.str, "AllTypes::deserialize() (inline str)");
+    assertEqual(source.arr, inlineTarget.arr, "AllTypes::deserialize() (inline arr)");
+    assertEqual(source.deque, inlineTarget.deque, "AllTypes::deserialize() (inline deque)");
+    assertEqual(source.map, inlineTarget.map, "AllTypes::deserialize() (inline map)");
+    assertEqual(&inlineTarget, inlineTarget.p, "AllTypes::deserialize() (inline p)");
+
     // Serialize nullptr
     source.p = nullptr;
     assertEqual(AllTypes::Result::POINTER, source.serialize().first, "AllTypes::serialize() (nullptr)");
@@ -532,6 +810,1014 @@ void testNested() {
     assertEqual(Nested::Result::OK, target.deserialize(serial.second), "Nested::deserialize() (result)");
     assertEqual(source.primary.value, target.primary.value, "Nested::deserialize() (primary)");
     assertEqual(source.secondary.value, target.secondary.value, "Nested::deserialize() (secondary)");
+
+    // Inline objects (pretty and compact)
+    serializable::Options options;
+    options.inlining = true;
+    for(const bool compact : { false, true }) {
+        options.compact  = compact;
+        const auto lines = source.serialize(options);
+        assertEqual(Nested::Result::OK, lines.first, "Nested::serialize() (inline result)");
+        const std::string inlined = compact ? "{INT value=42}" : " { INT value = 42 }";
+        assert(lines.second.find(inlined) != std::string::npos, "Nested::serialize() (inline data)");
+        assert(lines.second.size() < serial.second.size(), "Nested::serialize() (inline size)");
+
+        Nested inlineTarget;
+        assertEqual(Nested::Result::OK, inlineTarget.deserialize(lines.second), "Nested::deserialize() (inline)");
+        assertEqual(source.primary.value, inlineTarget.primary.value, "Nested::deserialize() (inline primary)");
+        assertEqual(source.secondary.value, inlineTarget.secondary.value, "Nested::deserialize() (inline secondary)");
+    }
+}
+
+// Packed
+struct Packed : public serializable::Serializable {
+    std::vector<long> timestamps;
+    std::list<unsigned int> ticks;
+    std::array<int, 4> ids{};
+    std::deque<char> levels;
+    std::vector<int> plain;
+    std::vector<int> grid;
+    std::array<float, 6> histogram{};
+    std::vector<double> samples;
+
+    void exposed() override {
+        expose("timestamps", timestamps, Encoding::DELTA);
+        expose("ticks", ticks, Encoding::DELTA_OF_DELTA);
+        expose("ids", ids, Encoding::FRAME_OF_REFERENCE);
+        expose("levels", levels, Encoding::AUTO);
+        expose("plain", plain);
+        expose("grid", grid, Encoding::AUTO);
+        expose("histogram", histogram, Encoding::RUN_LENGTH);
+        expose("samples", samples, Encoding::DELTA);
+    }
+};
+
+void testPacked() {
+    Packed source;
+    source.timestamps = { 1700000000, 1700000060, 1700000120, 1700000180 };
+    source.ticks      = { 5, 10, 15, 20, 25 };
+    source.ids        = { 1000, 1003, 1001, 1002 };
+    source.levels     = { -1, 0, 1, 0, -1 };
+    source.plain      = { 1, 2, 3 };
+    source.grid.assign(10000, 0);
+    source.grid[1234] = 1;
+    source.grid[5678] = 2;
+    source.histogram  = { 0.5F, 0.5F, 0.5F, 0, 0, 0.25F };
+    source.samples    = { 1.1, 1.1, 2.5 };
+
+    const auto serial = source.serialize();
+    assertEqual(Packed::Result::OK, serial.first, "Packed::serialize() (result)");
+    assert(serial.second.find("DELTA<LONG> values = 4 1700000000 60 60 60") != std::string::npos,
+           "Packed::serialize() (delta)");
+    assert(serial.second.find("DELTA_OF_DELTA<UINT> values = 5 5 5 0 0 0") != std::string::npos,
+           "Packed::serialize() (delta of delta)");
+    assert(serial.second.find("FRAME_OF_REFERENCE<INT> values = 4 1000 2 ") != std::string::npos,
+           "Packed::serialize() (frame of reference)");
+    assert(serial.second.find("<CHAR> values = 5 ") != std::string::npos, "Packed::serialize() (auto)");
+    assert(serial.second.find("INT 2 = 3") != std::string::npos, "Packed::serialize() (plain)");
+    assert(serial.second.find("SPARSE<INT> values = 10000 0 1234 1 4444 2") != std::string::npos,
+           "Packed::serialize() (sparse)");
+    assert(serial.second.find("RUN_LENGTH<FLOAT> values = 6 0.5 3 0 2 0.25 1") != std::string::npos,
+           "Packed::serialize() (run length)");
+    assert(serial.second.find("SPARSE<DOUBLE> values = 3 1.1 2 2.5") != std::string::npos,
+           "Packed::serialize() (floats chosen automatically)");
+
+    Packed target;
+    target.ids = {};
+    assertEqual(Packed::Result::OK, target.deserialize(serial.second), "Packed::deserialize() (result)");
+    assertEqual(source.timestamps, target.timestamps, "Packed::deserialize() (timestamps)");
+    assertEqual(source.ticks, target.ticks, "Packed::deserialize() (ticks)");
+    assertEqual(source.ids, target.ids, "Packed::deserialize() (ids)");
+    assertEqual(source.levels, target.levels, "Packed::deserialize() (levels)");
+    assertEqual(source.plain, target.plain, "Packed::deserialize() (plain)");
+    assertEqual(source.grid, target.grid, "Packed::deserialize() (grid)");
+    assertEqual(source.histogram, target.histogram, "Packed::deserialize() (histogram)");
+    assertEqual(source.samples, target.samples, "Packed::deserialize() (samples)");
+
+    // Packed values of the wrong type
+    const auto retyped = serializable::detail::string::replaceAll(serial.second, "DELTA<LONG>", "DELTA<INT>");
+    assertEqual(Packed::Result::TYPECHECK, target.deserialize(retyped), "Packed::deserialize() (wrong type)");
+
+    // Packed array of the wrong size
+    const auto resized = serializable::detail::string::replaceAll(serial.second, "<INT> values = 4 1000 2 ",
+                                                                  "<INT> values = 3 1000 2 ");
+    assertEqual(Packed::Result::INTEGRITY, target.deserialize(resized), "Packed::deserialize() (wrong size)");
+
+    // Short packed values claiming huge counts (beyond their data or the size of the array)
+    const auto runs = serializable::detail::string::replaceAll(
+      serial.second, "RUN_LENGTH<FLOAT> values = 6 0.5 3 0 2 0.25 1", "RUN_LENGTH<FLOAT> values = 67108864 0 67108864");
+    assertEqual(Packed::Result::STRUCTURE, target.deserialize(runs), "Packed::deserialize() (huge run)");
+    const auto sparse = serializable::detail::string::replaceAll(
+      serial.second, "RUN_LENGTH<FLOAT> values = 6 0.5 3 0 2 0.25 1", "SPARSE<FLOAT> values = 67108864 0");
+    assertEqual(Packed::Result::STRUCTURE, target.deserialize(sparse), "Packed::deserialize() (huge sparse)");
+}
+
+// Quantized
+struct Quantized : public serializable::Serializable {
+    float gain = 0;
+    std::vector<float> levels;
+    std::vector<double> weights;
+    double scale = 0.25; // Scale of the levels (not exposed)
+
+    void exposed() override {
+        expose("gain", gain, Quantization::fixed(0.5, 8));
+        expose("levels", levels, Quantization::fixed(scale, 16));
+        expose("weights", weights, Quantization::half());
+    }
+};
+
+void testQuantized() {
+    Quantized source;
+    source.gain    = 1.3F;
+    source.levels  = { 0.1F, 1, -2.6F, 0.3F, 7 };
+    source.weights = { 0.5, 1, 1000.3 };
+
+    const std::vector<float> levels   = { 0, 1, -2.5F, 0.25F, 7 };
+    const std::vector<double> weights = { 0.5, 1, 1000.5 };
+    for(const auto format : { serializable::Options::Format::TEXT, serializable::Options::Format::JSON }) {
+        serializable::Options options;
+        options.format    = format;
+        const auto serial = source.serialize(options);
+        assertEqual(Quantized::Result::OK, serial.first, "Quantized::serialize() (result)");
+        if(format == serializable::Options::Format::TEXT) {
+            assert(serial.second.find("FLOAT gain = 1.5") != std::string::npos, "Quantized::serialize() (single)");
+            assert(serial.second.find("FIXED<FLOAT> values = 0.25 5 -10 6 ") != std::string::npos,
+                   "Quantized::serialize() (fixed)");
+            assert(serial.second.find("HALF<DOUBLE> values = 3 ") != std::string::npos,
+                   "Quantized::serialize() (half)");
+        }
+
+        Quantized target;
+        assertEqual(Quantized::Result::OK, target.deserialize(serial.second, options),
+                    "Quantized::deserialize() (result)");
+        assertEqual(1.5F, target.gain, "Quantized::deserialize() (gain)");
+        assertEqual(levels, target.levels, "Quantized::deserialize() (levels)");
+        assertEqual(weights, target.weights, "Quantized::deserialize() (weights)");
+
+        // Scales that do not give readable fixed point numbers
+        for(const double scale : { 0.0, -0.25, std::numeric_limits<double>::quiet_NaN() }) {
+            source.scale = scale;
+            assertEqual(Quantized::Result::TYPECHECK, source.serialize(options).first,
+                        "Quantized::serialize() (invalid scale)");
+        }
+        source.scale = 0.25;
+    }
+}
+
+// Dictionary
+struct Dictionary : public serializable::Serializable {
+    std::vector<std::string> states;
+    std::map<std::string, std::string> regions;
+    std::string single;
+
+    void exposed() override {
+        expose("states", states);
+        expose("regions", regions);
+        expose("single", single);
+    }
+};
+
+void testDictionary() {
+    Dictionary source;
+    source.states  = { "active", "pending", "active", "active", "pending", "x", "x", "x" };
+    source.regions = {
+        {"alpha",   "eu-west"},
+        { "beta",   "eu-west"},
+        {"gamma", "us-east-1"}
+    };
+    source.single = "active";
+
+    serializable::Options options;
+    options.dictionary = true;
+
+    const auto plain  = source.serialize();
+    const auto serial = source.serialize(options);
+    assertEqual(Dictionary::Result::OK, serial.first, "Dictionary::serialize() (result)");
+    assert(serial.second.starts_with(
+             "VERSION 2\nSTRINGS {\n\t\"active\"\n\t\"eu-west\"\n\t\"pending\"\n}\nOBJECT<0> root"),
+           "Dictionary::serialize() (dictionary)");
+    assert(serial.second.find("STRING single = @0") != std::string::npos, "Dictionary::serialize() (reference)");
+    assert(serial.second.find("STRING 5 = \"x\"") != std::string::npos, "Dictionary::serialize() (short string)");
+    assert(serial.second.size() < plain.second.size(), "Dictionary::serialize() (size)");
+    assert(!plain.second.starts_with("STRINGS"), "Dictionary::serialize() (disabled)");
+
+    Dictionary target;
+    assertEqual(Dictionary::Result::OK, target.deserialize(serial.second), "Dictionary::deserialize() (result)");
+    assertEqual(source.states, target.states, "Dictionary::deserialize() (states)");
+    assertEqual(source.regions, target.regions, "Dictionary::deserialize() (regions)");
+    assertEqual(source.single, target.single, "Dictionary::deserialize() (single)");
+
+    // Compact dictionary
+    options.compact    = true;
+    const auto compact = source.serialize(options);
+    assert(compact.second.starts_with("VERSION 2\nSTRINGS{\n\"active\"\n\"eu-west\"\n\"pending\"\n}\nOBJECT<0> root="),
+           "Dictionary::serialize() (compact)");
+    assertEqual(Dictionary::Result::OK, target.deserialize(compact.second), "Dictionary::deserialize() (compact)");
+    assertEqual(source.regions, target.regions, "Dictionary::deserialize() (compact regions)");
+
+    // Reference outside of the dictionary
+    const auto tampered = serializable::detail::string::replaceAll(serial.second, "single = @0", "single = @9");
+    assertEqual(Dictionary::Result::TYPECHECK, target.deserialize(tampered), "Dictionary::deserialize() (invalid)");
+}
+
+// References
+struct Repeated : public serializable::Serializable {
+    Nested first, second, third;
+    Basic last;
+
+    Repeated() = default;
+
+    Repeated(int same, int other) : first(same, same), second(same, same), third(same + 1, other), last(other) {}
+
+    void exposed() override {
+        expose("first", first);
+        expose("second", second);
+        expose("third", third);
+        expose("last", last);
+    }
+};
+
+void testReferences() {
+    Repeated source(7, 9);
+
+    serializable::Options options;
+    options.references = true;
+
+    const auto plain  = source.serialize();
+    const auto serial = source.serialize(options);
+    assertEqual(Repeated::Result::OK, serial.first, "Repeated::serialize() (result)");
+    assert(serial.second.find("REF second = \"first\"\n") != std::string::npos, "Repeated::serialize() (object)");
+    assert(serial.second.find("REF secondary = \"first\" \"primary\"") != std::string::npos,
+           "Repeated::serialize() (nested)");
+    assert(serial.second.find("REF last = \"third\" \"secondary\"") != std::string::npos,
+           "Repeated::serialize() (path)");
+    assert(serial.second.size() < plain.second.size(), "Repeated::serialize() (size)");
+    assert(plain.second.find("REF") == std::string::npos, "Repeated::serialize() (disabled)");
+
+    for(const bool compact : { false, true }) {
+        options.compact = compact;
+        Repeated target;
+        assertEqual(Repeated::Result::OK, target.deserialize(source.serialize(options).second),
+                    "Repeated::deserialize() (result)");
+        assertEqual(7, target.first.secondary.value, "Repeated::deserialize() (first)");
+        assertEqual(7, target.second.primary.value, "Repeated::deserialize() (second primary)");
+        assertEqual(7, target.second.secondary.value, "Repeated::deserialize() (second secondary)");
+        assertEqual(9, target.third.secondary.value, "Repeated::deserialize() (third)");
+        assertEqual(9, target.last.value, "Repeated::deserialize() (last)");
+    }
+
+    // Paths
+    const auto path = serializable::detail::string::parsePath("\"a b\" \"c\\\"\"");
+    assert(path.has_value(), "parsePath() (result)");
+    assertEqual(std::vector<std::string>{ "a b", "c\"" }, path.value_or(std::vector<std::string>{}), "parsePath()");
+    assert(!serializable::detail::string::parsePath("").has_value(), "parsePath() (empty)");
+    assert(!serializable::detail::string::parsePath("\"a\"x").has_value(), "parsePath() (separator)");
+    assert(!serializable::detail::string::parsePath("\"a").has_value(), "parsePath() (unterminated)");
+
+    // Missing and cyclic references
+    Repeated target;
+    const auto missing = serializable::detail::string::replaceAll(serial.second, "\"third\" \"secondary\"", "\"x\"");
+    assertEqual(Repeated::Result::STRUCTURE, target.deserialize(missing), "Repeated::deserialize() (missing)");
+    const auto cyclic = serializable::detail::string::replaceAll(serial.second, "\"first\" \"primary\"", "\"first\"");
+    assertEqual(Repeated::Result::STRUCTURE, target.deserialize(cyclic), "Repeated::deserialize() (cyclic)");
+}
+
+// Canonical
+struct Canonical : public serializable::Serializable {
+    std::unordered_map<std::string, int> counts;
+    std::string label;
+
+    void exposed() override {
+        expose("label", label);
+        expose("counts", counts);
+    }
+};
+
+void testCanonical() {
+    // Equal maps with different buckets and insertion order
+    Canonical first, second;
+    first.label = second.label = "counts";
+    second.counts.reserve(1024);
+    for(int i = 0; i < 64; i++) first.counts[std::to_string(i)] = i;
+    for(int i = 63; i >= 0; i--) second.counts[std::to_string(i)] = i;
+
+    serializable::Options options;
+    options.canonical = true;
+    for(const auto format : { serializable::Options::Format::TEXT, serializable::Options::Format::JSON,
+                              serializable::Options::Format::MSGPACK }) {
+        options.format    = format;
+        const auto serial = first.serialize(options);
+        assertEqual(Canonical::Result::OK, serial.first, "Canonical::serialize() (result)");
+        assertEqual(serial.second, second.serialize(options).second, "Canonical::serialize() (equal)");
+
+        Canonical target;
+        assertEqual(Canonical::Result::OK, target.deserialize(serial.second), "Canonical::deserialize() (result)");
+        assertEqual(first.counts, target.counts, "Canonical::deserialize() (counts)");
+    }
+
+    // Members in exposure order, keys sorted
+    options.format    = serializable::Options::Format::JSON;
+    const auto serial = first.serialize(options).second;
+    assert(serial.starts_with("{\"label\":\"counts\",\"counts\":{\"0\":0,\"1\":1,\"10\":10,"),
+           "Canonical::serialize() (order)");
+}
+
+// Fingerprint
+void testFingerprint() {
+    const std::unordered_map<std::string, int> umap = {
+        {"c", 3},
+        {"d", 4}
+    };
+    AllTypes source(true, 'a', 'b', 1, 2, 3, 4, 5, 6, 7.0F, 8.0, "Hello World", AllTypes::Enum::XYZ, { 1, 2 }, { 3, 4 },
+                    { 5, 6 }, { 7, 8 }, { { "a", 1 } }, umap);
+    const auto fingerprint = source.fingerprint();
+    assertEqual(AllTypes::Result::OK, fingerprint.first, "AllTypes::fingerprint() (result)");
+    assertEqual(fingerprint.second, source.fingerprint().second, "AllTypes::fingerprint() (repeated)");
+
+    // Equal state (pointers by virtual address, maps by sorted keys)
+    AllTypes target;
+    assertEqual(AllTypes::Result::OK, target.deserialize(source.serialize().second), "AllTypes::deserialize()");
+    target.umap.clear();
+    target.umap.reserve(1024);
+    target.umap["d"] = 4;
+    target.umap["c"] = 3;
+    assertEqual(fingerprint.second, target.fingerprint().second, "AllTypes::fingerprint() (equal)");
+
+    // Changed state
+    target.vec.push_back(5);
+    assert(target.fingerprint().second != fingerprint.second, "AllTypes::fingerprint() (container)");
+    target.vec.pop_back();
+    target.str = "Hello World!";
+    assert(target.fingerprint().second != fingerprint.second, "AllTypes::fingerprint() (string)");
+    target.str = "Hello World";
+    target.list.back() = 7;
+    assert(target.fingerprint().second != fingerprint.second, "AllTypes::fingerprint() (list)");
+    target.list.back() = 6;
+    assertEqual(fingerprint.second, target.fingerprint().second, "AllTypes::fingerprint() (restored)");
+
+    // Nested objects
+    const auto nested = Nested(1, 2).fingerprint();
+    assertEqual(Nested::Result::OK, nested.first, "Nested::fingerprint() (result)");
+    assert(nested.second != Nested(2, 1).fingerprint().second, "Nested::fingerprint() (swapped)");
+
+    // Pointers without target
+    target.p = nullptr;
+    assertEqual(AllTypes::Result::POINTER, target.fingerprint().first, "AllTypes::fingerprint() (nullptr)");
+    AllTypes other;
+    target.p = &other;
+    assertEqual(AllTypes::Result::POINTER, target.fingerprint().first, "AllTypes::fingerprint() (outside)");
+}
+
+// Incremental
+struct Empty : public serializable::Serializable {
+    void exposed() override {}
+};
+
+struct Incremental : public serializable::Serializable {
+    Empty empty;
+    Repeated repeated{ 3, 4 };
+    std::vector<int> values;
+    std::map<std::string, std::string> names;
+
+    Incremental() {
+        for(int i = 0; i < 100; i++) values.push_back(i * i);
+        names = {
+            {"a",  "first"},
+            {"b", "second"},
+            {"c",  "first"}
+        };
+    }
+
+    void exposed() override {
+        expose("empty", empty);
+        expose("repeated", repeated);
+        expose("values", values);
+        expose("names", names);
+    }
+};
+
+void testIncremental() {
+    Incremental source;
+
+    // Same text as serializing at once, written a node per step (after the step collecting the tree)
+    serializable::Options options;
+    for(const int flags : { 0, 1, 2, 3, 4, 8 }) {
+        options.compact    = (flags & 1) != 0;
+        options.inlining   = (flags & 2) != 0;
+        options.dictionary = (flags & 4) != 0;
+        options.references = (flags & 8) != 0;
+        serializable::IncrementalSerializer serializer(source, options);
+        std::size_t steps = 0;
+        while(!serializer.step(1)) steps++;
+        assert(serializer.finished(), "IncrementalSerializer::finished()");
+        assert(steps > 100, "IncrementalSerializer::step() (steps)");
+
+        const auto [result, data] = serializer.finish();
+        assertEqual(Incremental::Result::OK, result, "IncrementalSerializer::finish() (result)");
+        assertEqual(source.serialize(options).second, data, "IncrementalSerializer::finish() (data)");
+    }
+
+    // The collected tree is written even if the object is changed, serialized or fingerprinted between steps
+    const std::string expected = source.serialize().second;
+    serializable::IncrementalSerializer owned(source);
+    assert(!owned.step(1) && !owned.step(1), "IncrementalSerializer::step() (owned)");
+    source.values.push_back(-1);
+    assertEqual(Incremental::Result::OK, source.fingerprint().first, "Incremental::fingerprint() (between steps)");
+    assert(!owned.step(10), "IncrementalSerializer::step() (after fingerprint)");
+    assertEqual(Incremental::Result::OK, source.serialize().first, "Incremental::serialize() (between steps)");
+    assertEqual(Incremental::Result::OK, source.deserialize(expected), "Incremental::deserialize() (between steps)");
+    assertEqual(expected, owned.finish().second, "IncrementalSerializer::finish() (owned)");
+
+    // Steps by time and the rest at once
+    serializable::IncrementalSerializer timed(source);
+    static_cast<void>(timed.step(std::chrono::microseconds(1)));
+    assertEqual(source.serialize().second, timed.finish().second, "IncrementalSerializer::step() (time)");
+
+    // Other formats are written in the first step
+    options.format = serializable::Options::Format::JSON;
+    serializable::IncrementalSerializer json(source, options);
+    assert(json.step(1), "IncrementalSerializer::step() (JSON)");
+    assertEqual(source.serialize(options).second, json.finish().second, "IncrementalSerializer::finish() (JSON)");
+
+    // Errors of the exposers
+    AllTypes invalid;
+    invalid.p = nullptr;
+    serializable::IncrementalSerializer failing(invalid);
+    assert(failing.step(1), "IncrementalSerializer::step() (error)");
+    assertEqual(AllTypes::Result::POINTER, failing.finish().first, "IncrementalSerializer::finish() (error)");
+}
+
+// Sparse
+struct Sparse : public serializable::Serializable {
+    Basic nested;
+    int retries       = 3;
+    double timeout    = 1.5;
+    bool verbose      = false;
+    std::string label = "default";
+    unsigned int port = 8080;
+
+    void exposed() override {
+        expose("nested", nested);
+        expose("retries", retries, 3);
+        expose("timeout", timeout, 1.5);
+        expose("verbose", verbose, false);
+        expose("label", label, "default");
+        expose("port", port);
+    }
+};
+
+void testSparse() {
+    Sparse source;
+    source.retries = 5;
+    source.label   = "custom";
+
+    serializable::Options options;
+    options.sparse = true;
+
+    // Values equal to their default are omitted (values without default are always written)
+    const auto plain  = source.serialize();
+    const auto serial = source.serialize(options);
+    assertEqual(Sparse::Result::OK, serial.first, "Sparse::serialize() (result)");
+    assert(serial.second.size() < plain.second.size(), "Sparse::serialize() (size)");
+    assert(serial.second.find("retries") != std::string::npos, "Sparse::serialize() (changed)");
+    assert(serial.second.find("timeout") == std::string::npos, "Sparse::serialize() (default)");
+    assert(serial.second.find("verbose") == std::string::npos, "Sparse::serialize() (default bool)");
+    assert(serial.second.find("port") != std::string::npos, "Sparse::serialize() (no default)");
+
+    // Missing values are read as their default
+    Sparse target;
+    target.timeout = 0;
+    target.verbose = true;
+    target.port    = 0;
+    assertEqual(Sparse::Result::OK, target.deserialize(serial.second, options), "Sparse::deserialize() (result)");
+    assertEqual(5, target.retries, "Sparse::deserialize() (retries)");
+    assertEqual(1.5, target.timeout, "Sparse::deserialize() (timeout)");
+    assertEqual(false, target.verbose, "Sparse::deserialize() (verbose)");
+    assertEqual("custom", target.label, "Sparse::deserialize() (label)");
+    assertEqual(8080U, target.port, "Sparse::deserialize() (port)");
+    assertEqual(Sparse::Result::INTEGRITY, target.deserialize(serial.second), "Sparse::deserialize() (not sparse)");
+
+    // Missing values without default are still an error
+    const auto missing = serializable::detail::string::replaceAll(serial.second, "UINT port", "UINT other");
+    assertEqual(Sparse::Result::INTEGRITY, target.deserialize(missing, options), "Sparse::deserialize() (missing)");
+
+    // JSON and positional MessagePack (which writes every value)
+    for(const bool positional : { false, true }) {
+        options.format     = positional ? serializable::Options::Format::MSGPACK : serializable::Options::Format::JSON;
+        options.positional = positional;
+        const auto data    = source.serialize(options);
+        target.timeout     = 0;
+        assertEqual(Sparse::Result::OK, target.deserialize(data.second, options), "Sparse::deserialize() (formats)");
+        assertEqual(1.5, target.timeout, "Sparse::deserialize() (formats timeout)");
+        assertEqual("custom", target.label, "Sparse::deserialize() (formats label)");
+    }
+}
+
+// Compression
+void testCodec(const serializable::Codec& codec, const char* name) {
+    std::string random(100000, '\0');
+    unsigned int seed = 42;
+    for(auto& c : random) c = static_cast<char>((seed = seed * 1103515245 + 12345) >> 16);
+
+    std::string repetitive;
+    for(int i = 0; i < 5000; i++) repetitive += "\tINT value = " + std::to_string(i % 7) + "\n";
+
+    for(const std::string& data : { std::string(), std::string("abc"), std::string(1000, 'x'), random, repetitive }) {
+        const std::string compressed = codec.compress(data);
+        assertEqual(data, codec.decompress(compressed, data.size()).value_or("<failed>"), name);
+    }
+
+    assert(codec.compress(repetitive).size() < repetitive.size() / 4, name);
+    assert(!codec.decompress(codec.compress(repetitive), repetitive.size() + 1), name);
+}
+
+void testCompression() {
+    testCodec(serializable::LZCodec(), "LZCodec");
+#if defined(SERIALIZABLE_ZLIB)
+    testCodec(serializable::ZlibCodec(), "ZlibCodec");
+#endif
+
+    // Corrupted LZ data
+    const serializable::LZCodec codec;
+    std::string compressed = codec.compress(std::string(1000, 'x'));
+    compressed[2]          = static_cast<char>(0xFF);
+    assert(!codec.decompress(compressed, 1000), "LZCodec::decompress() (corrupted)");
+
+    // Save and load compressed files with multiple blocks
+    Packed source;
+    source.timestamps.resize(1000);
+    for(std::size_t i = 0; i < source.timestamps.size(); i++) source.timestamps[i] = static_cast<long>(i * i);
+    source.plain.assign(2000, 7);
+
+    serializable::Options options;
+    options.codec     = std::make_shared<serializable::LZCodec>();
+    options.blockSize = 4096;
+    options.threads   = 3;
+    assertEqual(Packed::Result::OK, source.save("test.lz", options), "Packed::save() (compressed)");
+    assert(std::filesystem::file_size("test.lz") < source.serialize().second.size() / 2, "Packed::save() (size)");
+
+    Packed target;
+    assertEqual(Packed::Result::OK, target.load("test.lz"), "Packed::load() (compressed)");
+    assertEqual(source.timestamps, target.timestamps, "Packed::load() (compressed timestamps)");
+    assertEqual(source.plain, target.plain, "Packed::load() (compressed plain)");
+
+    // Truncated file
+    std::filesystem::resize_file("test.lz", std::filesystem::file_size("test.lz") - 5);
+    assertEqual(Packed::Result::STRUCTURE, target.load("test.lz"), "Packed::load() (truncated)");
+
+    // Block sizes larger than the data (read until the data ends, not allocated up front)
+    std::istringstream oversized(std::string("\0\0\xF0\xFF\xFF\xFF\xF0\xFF\xFF\xFF" "abc", 13));
+    assertEqual(Packed::Result::STRUCTURE, serializable::detail::frame::readBlocks(oversized).first,
+                "frame::readBlocks() (oversized)");
+}
+
+// Checksums
+void testChecksums() {
+    namespace checksum = serializable::detail::checksum;
+
+    // Test known values
+    assertEqual(0xE3069283U, checksum::crc32cSoftware("123456789"), "checksum::crc32cSoftware");
+    assertEqual(0xE3069283U, checksum::crc32cHardware("123456789"), "checksum::crc32cHardware");
+    assertEqual(0xE3069283U, checksum::crc32c("123456789"), "checksum::crc32c");
+    assertEqual(0x02CC5D05U, checksum::xxhash32(""), "checksum::xxhash32 (empty)");
+    assertEqual(0x32D153FFU, checksum::xxhash32("abc"), "checksum::xxhash32 (short)");
+    assertEqual(0xEF46DB3751D8E999U, checksum::xxhash64(""), "checksum::xxhash64 (empty)");
+    assertEqual(0x44BC2CF5AD770999U, checksum::xxhash64("abc"), "checksum::xxhash64 (short)");
+    assertEqual(0xFBCEA83C8A378BF1U, checksum::xxhash64("Nobody inspects the spammish repetition"),
+                "checksum::xxhash64 (long)");
+
+    // Test hardware and software implementations agree
+    std::string data;
+    for(int i = 0; i < 1000; i++) data += static_cast<char>(i * 7);
+    assertEqual(checksum::crc32cSoftware(data), checksum::crc32cHardware(data), "checksum::crc32c (long)");
+    assertEqual(checksum::crc32cSoftware(data, 42), checksum::crc32cHardware(data, 42), "checksum::crc32c (seeded)");
+
+    // Save and load checksummed files (with and without compression)
+    Basic source(42);
+    for(const auto type : { serializable::Options::Checksum::CRC32C, serializable::Options::Checksum::XXHASH32 }) {
+        for(const bool compressed : { false, true }) {
+            serializable::Options options;
+            options.checksum  = type;
+            options.codec     = compressed ? std::make_shared<serializable::LZCodec>() : nullptr;
+            options.blockSize = 8;
+            assertEqual(Basic::Result::OK, source.save("test.crc", options), "Basic::save() (checksum)");
+
+            Basic target;
+            assertEqual(Basic::Result::OK, target.load("test.crc"), "Basic::load() (checksum)");
+            assertEqual(source.value, target.value, "Basic::load() (checksum value)");
+        }
+    }
+
+    // Flip a bit in a stored block
+    std::string file;
+    {
+        std::ifstream stream("test.crc", std::ios::binary);
+        file.assign(std::istreambuf_iterator<char>(stream), {});
+    }
+    file[file.size() - 10] ^= 0x01;
+    std::ofstream("test.crc", std::ios::binary) << file;
+
+    Basic target;
+    assertEqual(Basic::Result::CHECKSUM, target.load("test.crc"), "Basic::load() (corrupted)");
+}
+
+// Headers
+void testHeaders() {
+    using namespace std::string_literals;
+    Basic source(42);
+    const std::string text = source.serialize().second;
+
+    // Text with header
+    Basic target;
+    assertEqual(Basic::Result::OK, target.deserialize("SRLZ\x01\x00\x00"s + text), "header (text)");
+    assertEqual(source.value, target.value, "header (text value)");
+
+    // Unsupported headers
+    assertEqual(Basic::Result::STRUCTURE, target.deserialize("SRLZ\x02\x00\x00"s + text), "header (newer version)");
+    assertEqual(Basic::Result::STRUCTURE, target.deserialize("SRLZ\x01\x7F\x00"s + text), "header (unknown format)");
+    assertEqual(Basic::Result::STRUCTURE, target.deserialize("SRLZ\x01\x00\x80"s + text), "header (unknown flags)");
+    assertEqual(Basic::Result::STRUCTURE, target.deserialize("SRLZ\x01"), "header (truncated)");
+
+    // Saved blocks start with a header and can also be deserialized from memory
+    serializable::Options options;
+    options.checksum = serializable::Options::Checksum::CRC32C;
+    assertEqual(Basic::Result::OK, source.save("test.srlz", options), "header (save)");
+
+    std::string file;
+    {
+        std::ifstream stream("test.srlz", std::ios::binary);
+        file.assign(std::istreambuf_iterator<char>(stream), {});
+    }
+    assert(file.starts_with("SRLZ\x01\x00\x01\x00\x01"s), "header (saved blocks)");
+    assertEqual(Basic::Result::OK, target.deserialize(file), "header (deserialize blocks)");
+}
+
+// Streaming
+void testStreaming() {
+    std::string data;
+    for(int i = 0; i < 1000; i++) data += "line " + std::to_string(i) + '\n';
+
+    serializable::Options options;
+    options.codec     = std::make_shared<serializable::LZCodec>();
+    options.checksum  = serializable::Options::Checksum::XXHASH32;
+    options.blockSize = 100;
+    options.threads   = 3;
+
+    // Writing in chunks of any size equals writing everything at once
+    std::ostringstream whole;
+    assert(serializable::detail::frame::writeBlocks(whole, data, options), "writeBlocks()");
+    for(const std::size_t chunkSize : { 1, 7, 100, 299, 300, 5000 }) {
+        std::ostringstream chunked;
+        serializable::detail::frame::BlockWriter writer(chunked, options);
+        for(std::size_t i = 0; i < data.size(); i += chunkSize)
+            writer.write(std::string_view(data).substr(i, chunkSize));
+        assert(writer.finish(), "BlockWriter::finish()");
+        assert(whole.str() == chunked.str(), "BlockWriter::write() (chunked)");
+    }
+
+    // Reading passes blocks on in order
+    std::istringstream stream(whole.str());
+    std::string read;
+    std::size_t blocks = 0;
+    const auto result  = serializable::detail::frame::readBlocks(stream, [&](std::string_view block) {
+        read.append(block);
+        blocks++;
+    });
+    assertEqual(serializable::Serializable::Result::OK, result, "readBlocks() (streaming)");
+    assertEqual(data, read, "readBlocks() (streaming data)");
+    assertEqual((data.size() + 99) / 100, blocks, "readBlocks() (streaming blocks)");
+}
+
+// Temporal
+struct Telemetry : public serializable::Serializable {
+    long tick         = 0;
+    int counter       = 0;
+    float temperature = 0;
+    double position   = 0;
+    std::string state;
+    std::vector<int> samples;
+    Basic basic;
+
+    void exposed() override {
+        expose("tick", tick);
+        expose("counter", counter);
+        expose("temperature", temperature);
+        expose("position", position);
+        expose("state", state);
+        expose("samples", samples);
+        expose("basic", basic);
+    }
+};
+
+void testTemporal() {
+    namespace temporal = serializable::detail::temporal;
+    namespace str      = serializable::detail::string;
+
+    // Test temporal::BitWriter and temporal::BitReader
+    temporal::BitWriter writer;
+    writer.write(0b101, 3);
+    writer.write(0x123456789ABCDEF0, 64);
+    writer.write(1, 1);
+    const std::string bits = writer.finish();
+    assertEqual(std::size_t{ 9 }, bits.size(), "temporal::BitWriter::finish()");
+    temporal::BitReader reader(bits);
+    assertEqual(std::uint64_t{ 0b101 }, reader.read(3).value_or(0), "temporal::BitReader::read()");
+    assertEqual(std::uint64_t{ 0x123456789ABCDEF0 }, reader.read(64).value_or(0), "temporal::BitReader::read() (64)");
+    assertEqual(std::uint64_t{ 1 }, reader.read(1).value_or(0), "temporal::BitReader::read() (last)");
+    assert(reader.finished(), "temporal::BitReader::finished()");
+    assert(!reader.read(5), "temporal::BitReader::read() (past end)");
+
+    // Test temporal::makeField and temporal::decodeField (sizes of changed strings are checked against the data)
+    assert(temporal::makeField(str::TypeToString<unsigned short>, "7").kind == temporal::Kind::UNSIGNED,
+           "temporal::makeField() (unsigned short)");
+    assert(temporal::makeField(str::TypeToString<short>, "-7").kind == temporal::Kind::SIGNED,
+           "temporal::makeField() (short)");
+    writer.write(1, 1);
+    writer.write(0xFFFFFFFF, 32);
+    const std::string oversized = writer.finish();
+    temporal::BitReader oversizedReader(oversized);
+    auto field = temporal::makeField(str::TypeToString<std::string>, "\"idle\"");
+    assert(!temporal::decodeField(oversizedReader, field), "temporal::decodeField() (oversized string)");
+
+    // Successive snapshots (keyframe every four frames, the structure changes in frame 6)
+    Telemetry source, target;
+    serializable::TemporalEncoder encoder(source, 4);
+    serializable::TemporalDecoder decoder(target);
+    source.state   = "idle";
+    source.samples = { 1, 2, 3 };
+    std::size_t deltaSize = 0;
+    std::string delta;
+    for(int frame = 0; frame < 10; frame++) {
+        source.tick        = 1700000000 + frame * 60;
+        source.counter     = frame % 3 == 0 ? frame : source.counter;
+        source.temperature = 20.5F + static_cast<float>(frame % 2) * 0.25F;
+        source.position    = -1.5 + frame * 0.5;
+        source.state       = frame == 2 ? "busy" : source.state;
+        source.basic.value = -frame;
+        if(frame == 6) source.samples.push_back(4);
+
+        const auto [result, data] = encoder.encode();
+        assertEqual(Telemetry::Result::OK, result, "TemporalEncoder::encode() (result)");
+        const bool keyframe = frame == 0 || frame == 4 || frame == 6;
+        assertEqual(keyframe ? 'K' : 'D', data.at(0), "TemporalEncoder::encode() (keyframe)");
+        if(!keyframe && frame != 2) deltaSize = std::max(deltaSize, data.size());
+        if(!keyframe) delta = data;
+
+        assertEqual(Telemetry::Result::OK, decoder.decode(data), "TemporalDecoder::decode() (result)");
+        assertEqual(source.tick, target.tick, "TemporalDecoder::decode() (tick)");
+        assertEqual(source.counter, target.counter, "TemporalDecoder::decode() (counter)");
+        assertEqual(source.temperature, target.temperature, "TemporalDecoder::decode() (temperature)");
+        assertEqual(source.position, target.position, "TemporalDecoder::decode() (position)");
+        assertEqual(source.state, target.state, "TemporalDecoder::decode() (state)");
+        assertEqual(source.samples, target.samples, "TemporalDecoder::decode() (samples)");
+        assertEqual(source.basic.value, target.basic.value, "TemporalDecoder::decode() (basic)");
+    }
+    assert(deltaSize > 0 && deltaSize <= 12, "TemporalEncoder::encode() (delta size)");
+
+    // Delta frames without keyframe, broken delta frames and frames following them
+    serializable::TemporalDecoder fresh(target);
+    assertEqual(Telemetry::Result::STRUCTURE, fresh.decode(delta), "TemporalDecoder::decode() (no keyframe)");
+    assertEqual(Telemetry::Result::STRUCTURE, decoder.decode(delta.substr(0, 1)),
+                "TemporalDecoder::decode() (truncated)");
+    assertEqual(Telemetry::Result::STRUCTURE, decoder.decode(delta), "TemporalDecoder::decode() (after broken)");
+    assertEqual(Telemetry::Result::STRUCTURE, decoder.decode("X"), "TemporalDecoder::decode() (unknown frame)");
+}
+
+// JSON
+struct Sized : public serializable::Serializable {
+    std::size_t size = 0;
+
+    void exposed() override { expose("size", size); }
+};
+
+void testJSON() {
+    serializable::Options options;
+    options.format = serializable::Options::Format::JSON;
+
+    // Basic document
+    Basic basic(42);
+    assertEqual("{\"value\":42}", basic.serialize(options).second, "Basic::serialize() (JSON)");
+
+    Basic basicTarget;
+    assertEqual(Basic::Result::OK, basicTarget.deserialize(" {\n  \"value\": -7\n}\n"), "Basic::deserialize() (JSON)");
+    assertEqual(-7, basicTarget.value, "Basic::deserialize() (JSON value)");
+
+    // Typed checks and malformed documents
+    assertEqual(Basic::Result::TYPECHECK, basicTarget.deserialize("{\"value\":4.5}"), "JSON (fraction)");
+    assertEqual(Basic::Result::TYPECHECK, basicTarget.deserialize("{\"value\":1e3}"), "JSON (exponent)");
+    assertEqual(Basic::Result::TYPECHECK, basicTarget.deserialize("{\"value\":\"42\"}"), "JSON (string)");
+    assertEqual(Basic::Result::TYPECHECK, basicTarget.deserialize("{\"value\":true}"), "JSON (bool)");
+    assertEqual(Basic::Result::TYPECHECK, basicTarget.deserialize("{\"value\":9999999999}"), "JSON (range)");
+    assertEqual(Basic::Result::INTEGRITY, basicTarget.deserialize("{\"other\":42}"), "JSON (missing)");
+    assertEqual(Basic::Result::STRUCTURE, basicTarget.deserialize("{\"value\":42"), "JSON (unterminated)");
+    assertEqual(Basic::Result::STRUCTURE, basicTarget.deserialize("{\"value\":042}"), "JSON (leading zero)");
+    assertEqual(Basic::Result::STRUCTURE, basicTarget.deserialize("{\"value\":42} x"), "JSON (trailing data)");
+    assertEqual(Basic::Result::STRUCTURE, basicTarget.deserialize("{\"value\":null}"), "JSON (null)");
+
+    // All types (containers as arrays, maps as objects, pointers as references)
+    AllTypes source(true, 'a', 'b', 1, 2, 3, 4, 5, 6, 7.5F, 8.25, "Hello \"World\"\n", AllTypes::Enum::XYZ, { 1, 2 },
+                    { 3, 4 }, { 5, 6 }, { 7, 8 }, { { "a", 1 }, { "b", 2 } }, { { "c", 3 } });
+    const auto serial = source.serialize(options);
+    assertEqual(AllTypes::Result::OK, serial.first, "AllTypes::serialize() (JSON result)");
+    assert(serial.second.starts_with("{\"$class\":1,\"$id\":1,"), "AllTypes::serialize() (JSON class)");
+    assert(serial.second.find("\"vec\":[3,4]") != std::string::npos, "AllTypes::serialize() (JSON array)");
+    assert(serial.second.find("\"map\":{\"a\":1,\"b\":2}") != std::string::npos, "AllTypes::serialize() (JSON map)");
+    assert(serial.second.find("\"p\":{\"$class\":1,\"$ref\":1}") != std::string::npos,
+           "AllTypes::serialize() (JSON pointer)");
+    assert(serial.second.find("\"str\":\"Hello \\\"World\\\"\\n\"") != std::string::npos,
+           "AllTypes::serialize() (JSON string)");
+
+    AllTypes target;
+    assertEqual(AllTypes::Result::OK, target.deserialize(serial.second), "AllTypes::deserialize() (JSON result)");
+    assertEqual(source.b, target.b, "AllTypes::deserialize() (JSON b)");
+    assertEqual(source.c, target.c, "AllTypes::deserialize() (JSON c)");
+    assertEqual(source.ul, target.ul, "AllTypes::deserialize() (JSON ul)");
+    assertEqual(source.f, target.f, "AllTypes::deserialize() (JSON f)");
+    assertEqual(source.d, target.d, "AllTypes::deserialize() (JSON d)");
+    assertEqual(source.str, target.str, "AllTypes::deserialize() (JSON str)");
+    assertEqual(source.e, target.e, "AllTypes::deserialize() (JSON e)");
+    assertEqual(&target, target.p, "AllTypes::deserialize() (JSON p)");
+    assertEqual(source.arr, target.arr, "AllTypes::deserialize() (JSON arr)");
+    assertEqual(source.list, target.list, "AllTypes::deserialize() (JSON list)");
+    assertEqual(source.map, target.map, "AllTypes::deserialize() (JSON map)");
+    assertEqual(source.umap, target.umap, "AllTypes::deserialize() (JSON umap)");
+
+    // Escape sequences
+    Dictionary strings;
+    const std::string escaped = "{\"states\":[\"\\u00e9\\ud83d\\ude00\", \"a\\tb\\/\"],\"regions\":{},\"single\":\"\"}";
+    assertEqual(Dictionary::Result::OK, strings.deserialize(escaped), "Dictionary::deserialize() (JSON escapes)");
+    assertEqual(std::vector<std::string>{ "\u00e9\U0001F600", "a\tb/" }, strings.states,
+                "Dictionary::deserialize() (JSON escaped states)");
+    strings.single = std::string("control \x01 characters\r");
+    Dictionary stringsTarget;
+    assertEqual(Dictionary::Result::OK, stringsTarget.deserialize(strings.serialize(options).second),
+                "Dictionary::deserialize() (JSON round trip)");
+    assertEqual(strings.single, stringsTarget.single, "Dictionary::deserialize() (JSON control characters)");
+    assertEqual(Dictionary::Result::STRUCTURE, strings.deserialize("{\"single\":\"\\ude00\"}"), "JSON (surrogate)");
+
+    // Packed containers are written as arrays
+    Packed packed;
+    packed.timestamps = { 10, 20, 30 };
+    assert(packed.serialize(options).second.find("\"timestamps\":[10,20,30]") != std::string::npos, "Packed (JSON)");
+
+    // Objects whose members look like the size of a container are still written as objects
+    Sized sized;
+    assertEqual("{\"size\":0}", sized.serialize(options).second, "Sized::serialize() (JSON)");
+    Sized sizedTarget;
+    assertEqual(Sized::Result::OK, sizedTarget.deserialize(sized.serialize(options).second),
+                "Sized::deserialize() (JSON)");
+
+    // Compressed JSON files
+    options.codec = std::make_shared<serializable::LZCodec>();
+    assertEqual(AllTypes::Result::OK, source.save("test.json", options), "AllTypes::save() (JSON)");
+    AllTypes loaded;
+    assertEqual(AllTypes::Result::OK, loaded.load("test.json"), "AllTypes::load() (JSON)");
+    assertEqual(source.deque, loaded.deque, "AllTypes::load() (JSON deque)");
+}
+
+// Bit fields
+enum class Color : unsigned char { RED, GREEN, BLUE };
+enum class Level : short { LOW = -2, HIGH = 2 };
+
+template <> inline const constexpr std::optional<Color> serializable::EnumMaximum<Color> = Color::BLUE;
+
+struct Flags : public serializable::Serializable {
+    std::array<bool, 10> flags{};
+    Color color = Color::RED;
+    Level level = Level::HIGH;
+    int count   = 0;
+    bool first = false, second = false;
+
+    void exposed() override {
+        for(std::size_t i = 0; i < flags.size(); i++) expose("flag" + std::to_string(i), flags.at(i));
+        expose("color", color);
+        expose("level", level);
+        expose("count", count);
+        expose("first", first);
+        expose("second", second);
+    }
+};
+
+void testBitfields() {
+    serializable::Options options;
+    options.format     = serializable::Options::Format::MSGPACK;
+    options.positional = true;
+    options.bitfields  = true;
+
+    // Bools take a bit, enums the bits of their maximum or of their underlying type (a member in between starts over)
+    Flags source;
+    source.flags.at(0) = true;
+    source.flags.at(3) = true;
+    source.flags.at(9) = true;
+    source.color       = Color::BLUE;
+    source.level       = Level::LOW;
+    source.count       = 7;
+    source.first       = true;
+    const auto serial  = source.serialize(options);
+    assertEqual(Flags::Result::OK, serial.first, "Flags::serialize() (result)");
+    assertEqual(std::string("\x93\xCE\x0F\xFF\xEA\x09\x07\x01", 8), serial.second,
+                "Flags::serialize() (bit fields)");
+
+    Flags target;
+    assertEqual(Flags::Result::OK, target.deserialize(serial.second, options), "Flags::deserialize() (result)");
+    assertEqual(source.flags, target.flags, "Flags::deserialize() (flags)");
+    assert(target.color == Color::BLUE && target.level == Level::LOW, "Flags::deserialize() (enums)");
+    assertEqual(7, target.count, "Flags::deserialize() (count)");
+    assert(target.first && !target.second, "Flags::deserialize() (bools after member)");
+
+    // Enums beyond their declared maximum don't fit into their bits
+    Flags overflow;
+    overflow.color = static_cast<Color>(4);
+    assertEqual(Flags::Result::TYPECHECK, overflow.serialize(options).first, "Flags::serialize() (enum overflow)");
+
+    // Bit fields are only used for positional MessagePack and have to be expected when reading
+    assertEqual(Flags::Result::TYPECHECK, target.deserialize(serial.second), "Flags::deserialize() (not expected)");
+    serializable::Options map;
+    map.format         = serializable::Options::Format::MSGPACK;
+    options.positional = false;
+    assertEqual(source.serialize(map).second, source.serialize(options).second, "Flags::serialize() (map)");
+}
+
+// MessagePack
+void testMsgPack() {
+    serializable::Options options;
+    options.format = serializable::Options::Format::MSGPACK;
+
+    // Objects as maps or positional arrays
+    Basic basic(5);
+    assertEqual(std::string("\x81\xA5value\x05", 8), basic.serialize(options).second,
+                "Basic::serialize() (MessagePack)");
+    Nested nested(42, 24);
+    options.positional = true;
+    assertEqual(std::string("\x92\x91\x2A\x91\x18", 5), nested.serialize(options).second,
+                "Nested::serialize() (MessagePack positional)");
+    Nested nestedTarget;
+    assertEqual(Nested::Result::OK, nestedTarget.deserialize(nested.serialize(options).second),
+                "Nested::deserialize() (MessagePack positional)");
+    assertEqual(24, nestedTarget.secondary.value, "Nested::deserialize() (MessagePack positional value)");
+    options.positional = false;
+
+    // Documents written elsewhere, typed checks and malformed documents
+    Basic basicTarget;
+    assertEqual(Basic::Result::OK, basicTarget.deserialize(std::string("\x81\xA5value\xD0\x80", 9)),
+                "Basic::deserialize() (MessagePack int 8)");
+    assertEqual(-128, basicTarget.value, "Basic::deserialize() (MessagePack int 8 value)");
+    assertEqual(Basic::Result::TYPECHECK, basicTarget.deserialize(std::string("\x81\xA5value\xCA\x40\0\0\0", 12)),
+                "MessagePack (float)");
+    assertEqual(Basic::Result::TYPECHECK, basicTarget.deserialize(std::string("\x81\xA5value\xCF\1\0\0\0\0\0\0\0", 16)),
+                "MessagePack (range)");
+    assertEqual(Basic::Result::STRUCTURE, basicTarget.deserialize("\x81\xA5val"), "MessagePack (truncated)");
+    assertEqual(Basic::Result::STRUCTURE, basicTarget.deserialize("\x81\xA5value\xC0"), "MessagePack (nil)");
+    assertEqual(Basic::Result::INTEGRITY, basicTarget.deserialize("\x90"), "MessagePack (missing member)");
+    AllTypes classTarget;
+    assertEqual(AllTypes::Result::TYPECHECK, classTarget.deserialize("\x91\xA5value"),
+                "MessagePack (positional class)");
+
+    // All types round trip, compared against the text format
+    AllTypes source(true, 'a', 'b', -300, 2, 3, 4, -5000000000, 1UL << 40, 7.5F, 8.25, "Hello \"World\"\n",
+                    AllTypes::Enum::XYZ, { 1, 2 }, { -3, 4 }, { 5, 6 }, { 7, 8 }, { { "a", 1 }, { "b", 2 } },
+                    { { "c", 3 } });
+    const auto text = source.serialize();
+    for(const bool positional : { false, true }) {
+        options.positional = positional;
+        const std::string mode = positional ? " (MessagePack positional)" : " (MessagePack)";
+        const auto serial      = source.serialize(options);
+        assertEqual(AllTypes::Result::OK, serial.first, ("AllTypes::serialize()" + mode).c_str());
+
+        AllTypes target;
+        assertEqual(AllTypes::Result::OK, target.deserialize(serial.second),
+                    ("AllTypes::deserialize()" + mode).c_str());
+        assertEqual(&target, target.p, ("AllTypes::deserialize() (p)" + mode).c_str());
+        assertEqual(text.second, target.serialize().second, ("AllTypes::deserialize() (text)" + mode).c_str());
+    }
+
+    // Caller buffers (the required size is returned if the buffer is too small)
+    std::array<char, 256> buffer{};
+    const auto [result, size] = source.serialize(buffer, options);
+    assertEqual(AllTypes::Result::OK, result, "AllTypes::serialize() (MessagePack buffer)");
+    assertEqual(source.serialize(options).second, std::string(buffer.data(), size),
+                "AllTypes::serialize() (MessagePack buffer data)");
+    std::array<char, 4> small{};
+    assertEqual(size, source.serialize(small, options).second, "AllTypes::serialize() (MessagePack small buffer)");
+    AllTypes bufferTarget;
+    assertEqual(AllTypes::Result::OK, bufferTarget.deserialize(std::string_view(buffer.data(), size)),
+                "AllTypes::deserialize() (MessagePack buffer)");
+    assertEqual(source.umap, bufferTarget.umap, "AllTypes::deserialize() (MessagePack buffer umap)");
+
+    // Objects whose members look like the size of a container
+    options.positional = false;
+    Sized sized;
+    assertEqual(std::string("\x81\xA4size\x00", 7), sized.serialize(options).second,
+                "Sized::serialize() (MessagePack)");
+    Sized sizedTarget;
+    assertEqual(Sized::Result::OK, sizedTarget.deserialize(sized.serialize(options).second),
+                "Sized::deserialize() (MessagePack)");
+
+    // Files without header
+    assertEqual(AllTypes::Result::OK, source.save("test.msgpack", options), "AllTypes::save() (MessagePack)");
+    AllTypes loaded;
+    assertEqual(AllTypes::Result::OK, loaded.load("test.msgpack"), "AllTypes::load() (MessagePack)");
+    assertEqual(source.str, loaded.str, "AllTypes::load() (MessagePack str)");
 }
 
 // Files
@@ -545,6 +1831,111 @@ void testFiles() {
     assertEqual(source.value, target.value, "Basic::load() (value)");
 
     assertEqual(Basic::Result::FILE, target.load("non-existent.txt"), "Basic::load() (non-existent)");
+
+    // Skip unchanged files (files dated back are only left alone if they hold the data, other framing is a change)
+    serializable::Options options;
+    options.skipUnchanged = true;
+    options.checksum      = serializable::Options::Checksum::CRC32C;
+    const auto past       = std::filesystem::file_time_type::clock::now() - std::chrono::hours(24);
+    assertEqual(Basic::Result::OK, source.save("test_unchanged.srlz", options), "Basic::save() (unchanged)");
+    std::filesystem::last_write_time("test_unchanged.srlz", past);
+    assertEqual(Basic::Result::OK, source.save("test_unchanged.srlz", options), "Basic::save() (skipped)");
+    assert(std::filesystem::last_write_time("test_unchanged.srlz") == past, "Basic::save() (not written)");
+
+    options.checksum = serializable::Options::Checksum::NONE;
+    assertEqual(Basic::Result::OK, source.save("test_unchanged.srlz", options), "Basic::save() (other framing)");
+    assert(std::filesystem::last_write_time("test_unchanged.srlz") != past, "Basic::save() (framing written)");
+    options.checksum = serializable::Options::Checksum::CRC32C;
+
+    source.value = 43;
+    assertEqual(Basic::Result::OK, source.save("test_unchanged.srlz", options), "Basic::save() (changed)");
+    assert(std::filesystem::last_write_time("test_unchanged.srlz") != past, "Basic::save() (written)");
+    assertEqual(Basic::Result::OK, target.load("test_unchanged.srlz"), "Basic::load() (changed)");
+    assertEqual(43, target.value, "Basic::load() (changed value)");
+
+    // Files modified by others are written again
+    const auto size = std::filesystem::file_size("test_unchanged.srlz");
+    std::ofstream("test_unchanged.srlz", std::ios::binary) << std::string(size, 'x');
+    std::filesystem::last_write_time("test_unchanged.srlz", past);
+    assertEqual(Basic::Result::OK, source.save("test_unchanged.srlz", options), "Basic::save() (modified)");
+    assertEqual(Basic::Result::OK, target.load("test_unchanged.srlz"), "Basic::load() (modified)");
+    assertEqual(43, target.value, "Basic::load() (modified value)");
+}
+
+// Snapshot store
+struct Archive : public serializable::Serializable {
+    int version = 0;
+    Nested nested;
+    Basic extra;
+    std::vector<int> history;
+
+    void exposed() override {
+        expose("version", version);
+        expose("nested", nested);
+        expose("extra", extra);
+        expose("history", history);
+    }
+};
+
+void testStore() {
+    std::filesystem::remove_all("test_store");
+    const serializable::SnapshotStore store("test_store");
+    const auto objects = [] {
+        return std::distance(std::filesystem::directory_iterator("test_store/objects"),
+                             std::filesystem::directory_iterator{});
+    };
+
+    // Every nested object is stored once, new snapshots only add the objects that changed
+    Archive source;
+    source.version                = 1;
+    source.history                = { 1, 2, 3 };
+    source.nested.primary.value   = 1;
+    source.nested.secondary.value = 2;
+    source.extra.value            = 3;
+    assertEqual(Archive::Result::OK, store.save(source, "v1"), "SnapshotStore::save()");
+    assertEqual(5L, objects(), "SnapshotStore::save() (objects)");
+    source.version     = 2;
+    source.extra.value = 4;
+    assertEqual(Archive::Result::OK, store.save(source, "v2"), "SnapshotStore::save() (second)");
+    assertEqual(6L, objects(), "SnapshotStore::save() (changed object)");
+    source.nested.secondary.value = 5;
+    assertEqual(Archive::Result::OK, store.save(source, "v3"), "SnapshotStore::save() (third)");
+    assertEqual(8L, objects(), "SnapshotStore::save() (changed nested object)");
+    assertEqual(Archive::Result::OK, store.save(source, "v3"), "SnapshotStore::save() (overwrite)");
+    assertEqual(8L, objects(), "SnapshotStore::save() (unchanged)");
+
+    // Objects are stored by their content only (extra now equals nested.primary), names have to stay in the store
+    source.extra.value = 1;
+    assertEqual(Archive::Result::OK, store.save(source, "shared"), "SnapshotStore::save() (shared)");
+    assertEqual(8L, objects(), "SnapshotStore::save() (equal object under another name)");
+    source.extra.value = 4;
+    assertEqual(Archive::Result::FILE, store.save(source, "../escaped"), "SnapshotStore::save() (parent directory)");
+    assertEqual(Archive::Result::FILE, store.save(source, "a/b"), "SnapshotStore::save() (separator)");
+
+    // Snapshots are reassembled from their objects
+    Archive target;
+    assertEqual(Archive::Result::OK, store.load(target, "v1"), "SnapshotStore::load()");
+    assertEqual(1, target.version, "SnapshotStore::load() (version)");
+    assertEqual(2, target.nested.secondary.value, "SnapshotStore::load() (nested)");
+    assertEqual(3, target.extra.value, "SnapshotStore::load() (extra)");
+    assertEqual(source.history, target.history, "SnapshotStore::load() (history)");
+    assertEqual(Archive::Result::OK, store.load(target, "v3"), "SnapshotStore::load() (third)");
+    assertEqual(5, target.nested.secondary.value, "SnapshotStore::load() (third nested)");
+    assertEqual(4, target.extra.value, "SnapshotStore::load() (third extra)");
+
+    // Missing snapshots, corrupted and missing objects
+    assertEqual(Archive::Result::FILE, store.load(target, "v4"), "SnapshotStore::load() (missing snapshot)");
+    assertEqual(Archive::Result::FILE, store.load(target, "../v3"), "SnapshotStore::load() (parent directory)");
+    std::ifstream manifest("test_store/snapshots/v3");
+    std::string line, hash;
+    while(std::getline(manifest, line))
+        if(line.find("SUBTREE extra = ") != std::string::npos) hash = line.substr(line.find(" = ") + 3);
+    const std::filesystem::path extra = "test_store/objects/" + hash;
+    assert(std::filesystem::exists(extra), "SnapshotStore::save() (manifest hash)");
+    std::ofstream(extra, std::ios::app) << "\n";
+    assertEqual(Archive::Result::CHECKSUM, store.load(target, "v3"), "SnapshotStore::load() (corrupted object)");
+    std::filesystem::remove(extra);
+    assertEqual(Archive::Result::FILE, store.load(target, "v3"), "SnapshotStore::load() (missing object)");
 }
 
 // Errors
@@ -583,14 +1974,36 @@ void testErrors() {
     res = errors.deserialize("");
     assertEqual(Errors::Result::STRUCTURE, res, "error (empty string)");
 
-    // JSON format
+    // JSON without class id
     res = errors.deserialize("{\n\t\"name\": \"value\"\n}");
-    assertEqual(Errors::Result::STRUCTURE, res, "error (JSON format)");
+    assertEqual(Errors::Result::TYPECHECK, res, "error (JSON class)");
 
     // Wrong value type
     res = errors.deserialize("OBJECT<2> root = 1 {\n\tSTRING name = 123\n}");
     assertEqual(Errors::Result::TYPECHECK, res, "error (wrong value type)");
 
+    // Invalid UTF-8 (only reported when validating)
+    serializable::Options validate;
+    validate.validate = true;
+    res               = errors.deserialize("OBJECT<2> root = 1 {\n\tSTRING name = \"val\xC0\xAFue\"\n}", validate);
+    assertEqual(Errors::Result::ENCODING, res, "error (invalid UTF-8)");
+    res = errors.deserialize("OBJECT<2> root = 1 {\n\tSTRING name = \"val\xC0\xAFue\"\n}");
+    assertEqual(Errors::Result::OK, res, "error (invalid UTF-8 without validation)");
+    res = errors.deserialize("OBJECT<2> root = 1 {\n\tSTRING name = \"v\xC3\xA4lue\"\n}", validate);
+    assertEqual(Errors::Result::OK, res, "error (valid UTF-8)");
+
+    // Text versions (unversioned text escapes with entities, unknown versions can not be read)
+    res = errors.deserialize("OBJECT<2> root = 1 {\n\tSTRING name = \"&quot;a\\b&newline;\"\n}");
+    assertEqual(Errors::Result::OK, res, "error (version 1)");
+    assertEqual("\"a\\b\n", errors.value, "error (version 1 value)");
+    res = errors.deserialize("VERSION 2\nOBJECT<2> root = 1 {\n\tSTRING name = \"\\\"&quot;\\\\\\n\"\n}");
+    assertEqual(Errors::Result::OK, res, "error (version 2)");
+    assertEqual("\"&quot;\\\n", errors.value, "error (version 2 value)");
+    res = errors.deserialize("VERSION 2\nOBJECT<2> root = 1 {\n\tSTRING name = \"a\\b\"\n}");
+    assertEqual(Errors::Result::TYPECHECK, res, "error (version 2 invalid escape)");
+    res = errors.deserialize("VERSION 3\nOBJECT<2> root = 1 {\n\tSTRING name = \"value\"\n}");
+    assertEqual(Errors::Result::STRUCTURE, res, "error (unknown version)");
+
     // Newline at end
     res = errors.deserialize("OBJECT<2> root = 1 {\n\tSTRING name = \"value\"\n}\n");
     assertEqual(Errors::Result::OK, res, "error (newline at end)");
@@ -604,7 +2017,7 @@ void testErrors() {
     errors.value = "value";
     auto serial  = errors.serialize();
     assertEqual(Errors::Result::OK, serial.first, "error (name with space)");
-    assertEqual("OBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second,
+    assertEqual("VERSION 2\nOBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second,
                 "error (name with space)");
     assertEqual(Errors::Result::OK, errors.deserialize(serial.second), "error (name with space)");
 
@@ -612,7 +2025,7 @@ void testErrors() {
     errors.name = "name with other funny characters: !@#$%^&*(){}_+|:\"<>?`-[]\\;',./";
     serial      = errors.serialize();
     assertEqual(Errors::Result::OK, serial.first, "error (name with other funny characters)");
-    assertEqual("OBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second,
+    assertEqual("VERSION 2\nOBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second,
                 "error (name with other funny characters)");
     assertEqual(Errors::Result::OK, errors.deserialize(serial.second), "error (name with other funny characters)");
 
@@ -620,7 +2033,7 @@ void testErrors() {
     errors.name = "INT name";
     serial      = errors.serialize();
     assertEqual(Errors::Result::OK, serial.first, "error (name starting with primitive identifier)");
-    assertEqual("OBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second,
+    assertEqual("VERSION 2\nOBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second,
                 "error (name starting with primitive identifier)");
     assertEqual(Errors::Result::OK, errors.deserialize(serial.second),
                 "error (name starting with primitive identifier)");
@@ -629,7 +2042,8 @@ void testErrors() {
     errors.name = "";
     serial      = errors.serialize();
     assertEqual(Errors::Result::OK, serial.first, "error (no name)");
-    assertEqual("OBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second, "error (no name) ");
+    assertEqual("VERSION 2\nOBJECT<2> root = 1 {\n\tSTRING " + errors.name + " = \"value\"\n}", serial.second,
+                "error (no name) ");
     assertEqual(Errors::Result::OK, errors.deserialize(serial.second), " error(no name) ");
 }
 
@@ -692,6 +2106,7 @@ int main() {
     testStringManipulation();
     testPrimitiveConversions();
     testParsers();
+    testPacking();
 
     testSerialPrimitive();
     testSerialObject();
@@ -700,8 +2115,25 @@ int main() {
     testBasic();
     testAllTypes();
     testNested();
+    testPacked();
+    testQuantized();
+    testDictionary();
+    testReferences();
+    testCanonical();
+    testFingerprint();
+    testIncremental();
+    testSparse();
 
     testFiles();
+    testStore();
+    testCompression();
+    testChecksums();
+    testHeaders();
+    testStreaming();
+    testTemporal();
+    testJSON();
+    testMsgPack();
+    testBitfields();
     testErrors();
     // stressTest();
 
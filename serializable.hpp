@@ -2,24 +2,60 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
+#include <charconv>
+#include <chrono>
 #include <climits>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <deque>
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <nmmintrin.h>
+#endif
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#if defined(__F16C__)
+    #include <immintrin.h>
+#endif
+
+#if defined(SERIALIZABLE_ZLIB)
+    #include <zlib.h>
+#endif
+
+#if defined(SERIALIZABLE_ZSTD)
+    #include <zstd.h>
+#endif
+
 namespace serializable {
 class Serializable;
 
@@ -30,6 +66,10 @@ template <typename T> concept SerializableObject = std::is_base_of_v<Serializabl
 
 template <typename T> concept Enum = std::is_enum_v<T>;
 
+template <typename T> concept Integer = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T> concept Arithmetic = Integer<T> || std::floating_point<T>;
+
 template <typename T> concept Number = requires(T t) {
     { std::to_string(t) } -> std::same_as<std::string>;
 };
@@ -39,6 +79,10 @@ class SerialPrimitive;
 class SerialObject;
 class SerialPointer;
 
+namespace msgpack {
+class Writer;
+} // namespace msgpack
+
 class Serial {
   public:
     Serial()                         = default;
@@ -48,10 +92,12 @@ class Serial {
     Serial& operator=(Serial&&)      = delete;
     virtual ~Serial()                = default;
 
-    [[nodiscard]] virtual std::string get() const               = 0;
-    [[nodiscard]] virtual bool set(const std::string& data)     = 0;
-    [[nodiscard]] virtual std::string getName() const           = 0;
-    [[nodiscard]] virtual std::unique_ptr<Serial> clone() const = 0;
+    [[nodiscard]] virtual std::string get(bool compact = false, bool inlining = false) const = 0;
+    [[nodiscard]] virtual bool set(const std::string& data)                                  = 0;
+    virtual void getJSON(std::string& data) const                                            = 0;
+    virtual void getMsgPack(msgpack::Writer& writer, bool positional) const                  = 0;
+    [[nodiscard]] virtual std::string getName() const                                        = 0;
+    [[nodiscard]] virtual std::unique_ptr<Serial> clone() const                              = 0;
 
     [[nodiscard]] SerialPrimitive* asPrimitive();
     [[nodiscard]] SerialObject* asObject();
@@ -63,13 +109,16 @@ class SerialPrimitive : public Serial {
     SerialPrimitive() = default;
     SerialPrimitive(std::string type, std::string name, std::string value);
 
-    [[nodiscard]] std::string get() const override;
+    [[nodiscard]] std::string get(bool compact = false, bool inlining = false) const override;
     [[nodiscard]] bool set(const std::string& data) override;
+    void getJSON(std::string& data) const override;
+    void getMsgPack(msgpack::Writer& writer, bool positional) const override;
     [[nodiscard]] std::string getName() const override;
     [[nodiscard]] std::unique_ptr<Serial> clone() const override;
 
     [[nodiscard]] std::string getType() const;
     [[nodiscard]] std::string getValue() const;
+    void setValue(std::string value);
 
   private:
     std::string type, name, value;
@@ -80,35 +129,63 @@ class SerialObject : public Serial {
     SerialObject() = default;
     SerialObject(unsigned int classID, std::string name, Address realAddress, Address virtualAddress);
 
-    [[nodiscard]] std::string get() const override;
+    [[nodiscard]] std::string get(bool compact = false, bool inlining = false) const override;
     [[nodiscard]] bool set(const std::string& data) override;
+    void getJSON(std::string& data) const override;
+    void getMsgPack(msgpack::Writer& writer, bool positional) const override;
     [[nodiscard]] std::string getName() const override;
     [[nodiscard]] std::unique_ptr<Serial> clone() const override;
 
     void emplace(unsigned int classID, std::string name, Address realAddress, Address virtualAddress);
+    [[nodiscard]] std::string getHeader(bool compact) const;
+    [[nodiscard]] std::optional<std::string> getInline(bool compact) const;
+    [[nodiscard]] std::vector<const Serial*> getChildren() const;
     void append(std::unique_ptr<Serial> child);
     [[nodiscard]] std::optional<Serial*> getChild(const std::string& name) const;
+    [[nodiscard]] const Serial* getLast() const;
+    void replace(const std::function<std::unique_ptr<Serial>(Serial&)>& replacement);
     [[nodiscard]] unsigned int getClass() const;
+    [[nodiscard]] Address getVirtualAddress() const;
+    [[nodiscard]] bool isPositional() const;
+    void setPositional(bool positional);
+    [[nodiscard]] bool isContainer() const;
+    void setContainer(bool container);
+    [[nodiscard]] std::size_t resolvePosition(unsigned int expectedClassID);
     void virtualizeAddresses(std::unordered_map<Address, Address>& addressMap);
     void restoreAddresses(std::unordered_map<Address, Address>& addressMap) const;
     [[nodiscard]] bool virtualizePointers(const std::unordered_map<Address, Address>& addressMap);
     [[nodiscard]] bool restorePointers(const std::unordered_map<Address, Address>& addressMap);
     void setRealAddress(Address address);
+    void countStrings(std::unordered_map<std::string, std::size_t>& counts) const;
+    void referenceStrings(const std::unordered_map<std::string, std::size_t>& dictionary);
+    void outline(std::string& structure, std::vector<SerialPrimitive*>& primitives);
+    void rename(std::string name);
+    std::size_t referenceObjects(std::unordered_map<std::string, std::pair<std::size_t, std::string>>& originals,
+                                 const std::string& path, std::string& key);
+    [[nodiscard]] bool resolveReferences(SerialObject& root, std::unordered_set<const SerialObject*>& resolving);
 
   private:
+    [[nodiscard]] std::optional<std::vector<const Serial*>> getElements() const;
+    [[nodiscard]] std::optional<std::vector<std::pair<std::string, const Serial*>>> getEntries() const;
+
     std::string name;
     unsigned int classID{};
     Address realAddress{}, virtualAddress{};
+    bool positional{}, container{};
     std::unordered_map<std::string, std::unique_ptr<Serial>> children;
+    std::vector<std::string> order; // Names of the children in the order they were appended
 };
 
 class SerialPointer : public Serial {
   public:
     SerialPointer() = default;
     SerialPointer(unsigned int classID, std::string name, void** location);
+    SerialPointer(unsigned int classID, std::string name, Address address);
 
-    [[nodiscard]] std::string get() const override;
+    [[nodiscard]] std::string get(bool compact = false, bool inlining = false) const override;
     [[nodiscard]] bool set(const std::string& data) override;
+    void getJSON(std::string& data) const override;
+    void getMsgPack(msgpack::Writer& writer, bool positional) const override;
     [[nodiscard]] std::string getName() const override;
     [[nodiscard]] std::unique_ptr<Serial> clone() const override;
 
@@ -133,6 +210,18 @@ std::string connect(const std::vector<std::string>& lines, char delimiter = '\n'
 std::vector<std::string> split(const std::string& data, char delimiter = '\n');
 std::string indent(const std::string& data);
 std::string unindent(const std::string& data);
+std::string encodeBase64(const std::vector<unsigned char>& bytes);
+std::optional<std::vector<unsigned char>> decodeBase64(const std::string& str);
+bool isUTF8(std::string_view str);
+
+// First line of text using backslash escapes in strings (text without it escapes quotes and newlines as entities)
+inline const constexpr std::string_view VERSION = "VERSION 2";
+
+// Maximum size of the children of an object written on its line (if inlining)
+inline const constexpr std::size_t INLINE_SIZE = 100;
+
+// Type of primitives referring to an identical object elsewhere in the text by its path
+inline const constexpr auto REFERENCE = "REF";
 
 template <typename T> inline const constexpr auto TypeToString       = "VOID";
 template <> inline const constexpr auto TypeToString<bool>           = "BOOL";
@@ -168,17 +257,154 @@ template <> std::optional<float> deserializePrimitive<float>(const std::string&
 template <> std::optional<double> deserializePrimitive<double>(const std::string& str);
 template <> std::optional<std::string> deserializePrimitive<std::string>(const std::string& str);
 template <Enum E> std::optional<E> deserializePrimitive(const std::string& str);
+std::optional<std::string> deserializeLegacyString(const std::string& str);
 
 std::optional<std::array<std::string, 3>> parsePrimitive(const std::string& data);
 std::optional<std::array<std::string, 4>> parseObject(const std::string& data);
 std::optional<std::array<std::string, 3>> parsePointer(const std::string& data);
+std::optional<std::array<std::string, 2>> parseDictionary(const std::string& data);
+std::optional<std::vector<std::string>> parsePath(const std::string& data);
 } // namespace string
 
+namespace packing {
+using Word = std::uint64_t;
+
+// Maximum count of packed elements not backed by data of their own (like equal values packed into zero bits or runs)
+inline const constexpr std::size_t MAX_ELEMENTS = std::size_t{ 1 } << 26;
+// Maximum count of elements runs may decode to per byte of their data (so memory grows with the data read)
+inline const constexpr std::size_t MAX_RUN_EXPANSION = 1024;
+
+[[nodiscard]] bool isEightDigits(std::uint64_t chunk);
+[[nodiscard]] std::uint64_t parseEightDigits(std::uint64_t chunk);
+template <Integer I> std::from_chars_result parseInteger(std::string_view data, I& value);
+template <std::floating_point F> std::from_chars_result parseFloat(std::string_view data, F& value);
+void prefixSum(std::span<Word> words);
+void appendWord(std::string& str, Word word);
+std::optional<std::vector<Word>> parseWords(const std::string& data);
+template <Integer I> std::optional<std::vector<I>> narrow(std::span<const Word> words);
+template <Arithmetic T> bool isSame(T a, T b);
+template <Arithmetic T> void appendValue(std::string& str, T value);
+template <Arithmetic T> bool parseValue(std::string_view& data, T& value);
+
+template <std::ranges::input_range R> std::string encodeDelta(const R& values);
+template <std::ranges::input_range R> std::string encodeDeltaOfDelta(const R& values);
+template <std::ranges::input_range R> std::string encodeFrameOfReference(const R& values);
+template <Integer I> std::optional<std::vector<I>> decodeDelta(const std::string& data);
+template <Integer I> std::optional<std::vector<I>> decodeDeltaOfDelta(const std::string& data);
+template <Integer I> std::optional<std::vector<I>> decodeFrameOfReference(const std::string& data);
+template <std::ranges::input_range R> std::string encodeRunLength(const R& values);
+template <std::ranges::input_range R> std::string encodeSparse(const R& values);
+template <Arithmetic T>
+std::optional<std::vector<T>> decodeRunLength(const std::string& data, std::size_t maximum = MAX_ELEMENTS);
+template <Arithmetic T>
+std::optional<std::vector<T>> decodeSparse(const std::string& data, std::size_t maximum = MAX_ELEMENTS);
+template <std::floating_point F>
+void quantize(std::span<const F> values, double scale, unsigned int bits, std::span<std::int32_t> codes);
+template <std::floating_point F>
+void dequantize(std::span<const std::int32_t> codes, double scale, std::span<F> values);
+std::uint16_t toHalf(float value);
+float fromHalf(std::uint16_t half);
+template <std::floating_point F> void toHalf(std::span<const F> values, std::span<std::uint16_t> halves);
+template <std::floating_point F> void fromHalf(std::span<const std::uint16_t> halves, std::span<F> values);
+template <std::floating_point F> std::string encodeFixed(std::span<const F> values, double scale, unsigned int bits);
+template <std::floating_point F> std::string encodeHalf(std::span<const F> values);
+template <std::floating_point F> std::optional<std::vector<F>> decodeFixed(const std::string& data);
+template <std::floating_point F> std::optional<std::vector<F>> decodeHalf(const std::string& data);
+} // namespace packing
+
+namespace checksum {
+std::uint32_t crc32c(std::string_view data, std::uint32_t crc = 0);
+std::uint32_t crc32cSoftware(std::string_view data, std::uint32_t crc = 0);
+std::uint32_t crc32cHardware(std::string_view data, std::uint32_t crc = 0);
+std::uint32_t xxhash32(std::string_view data, std::uint32_t seed = 0);
+std::uint64_t xxhash64(std::string_view data, std::uint64_t seed = 0);
+} // namespace checksum
+
 template <typename T> concept SerializablePrimitive = requires(T t) {
     { string::serializePrimitive(t) } -> std::same_as<std::string>;
     { string::deserializePrimitive<T>("") } -> std::same_as<std::optional<T>>;
 };
 
+namespace json {
+inline const constexpr auto NUMBER = "NUMBER"; // Type of (untyped) numbers read from JSON
+
+void writeString(std::string& data, std::string_view str);
+[[nodiscard]] bool isNumber(std::string_view str);
+[[nodiscard]] std::size_t scanString(std::string_view data, std::size_t pos);
+template <SerializablePrimitive P>
+std::optional<std::string> typedValue(const std::string& type, const std::string& value);
+[[nodiscard]] std::unique_ptr<Serial> finishObject(std::unique_ptr<SerialObject> object, std::string name,
+                                                   unsigned int classID, Address address, bool reference,
+                                                   const std::vector<std::string>& keys);
+
+// Parses a JSON document into serial objects (strings without escape sequences are not copied while parsing)
+class Parser {
+  public:
+    explicit Parser(std::string_view data);
+
+    [[nodiscard]] std::unique_ptr<SerialObject> parse();
+
+  private:
+    void skipWhitespace();
+    [[nodiscard]] bool consume(char c);
+    [[nodiscard]] std::optional<std::string_view> parseString();
+    [[nodiscard]] std::optional<std::string_view> parseNumber();
+    [[nodiscard]] std::unique_ptr<Serial> parseValue(std::string name);
+    [[nodiscard]] std::unique_ptr<Serial> parseObject(std::string name);
+    [[nodiscard]] std::unique_ptr<Serial> parseArray(std::string name);
+
+    std::string_view data;
+    std::size_t pos{};
+    std::string buffer;
+};
+} // namespace json
+
+namespace msgpack {
+// Writes MessagePack into a caller buffer (counting the bytes that don't fit instead of allocating) or a string
+class Writer {
+  public:
+    explicit Writer(std::span<char> buffer);
+    explicit Writer(std::string& data);
+
+    void writeBool(bool value);
+    void writeInteger(std::int64_t value);
+    void writeUnsigned(std::uint64_t value);
+    void writeFloat(float value);
+    void writeDouble(double value);
+    void writeString(std::string_view str);
+    void writeArray(std::size_t size);
+    void writeMap(std::size_t size);
+    [[nodiscard]] std::size_t size() const;
+
+  private:
+    void write(std::string_view bytes);
+    void writeBigEndian(unsigned char prefix, std::uint64_t value, std::size_t bytes);
+
+    std::span<char> buffer;
+    std::string* data{};
+    std::size_t count{};
+};
+
+// Parses MessagePack into serial objects (arrays become positional objects, strings are not copied while parsing)
+class Parser {
+  public:
+    explicit Parser(std::string_view data);
+
+    [[nodiscard]] std::unique_ptr<SerialObject> parse();
+
+  private:
+    [[nodiscard]] std::optional<std::uint64_t> readBigEndian(std::size_t bytes);
+    [[nodiscard]] std::optional<std::uint64_t> parseUnsigned();
+    [[nodiscard]] std::optional<std::string_view> parseString();
+    [[nodiscard]] std::unique_ptr<Serial> parseValue(std::string name);
+    [[nodiscard]] std::unique_ptr<Serial> parseMap(std::string name, std::size_t size);
+    [[nodiscard]] std::unique_ptr<Serial> parseArray(std::string name, std::size_t size);
+
+    std::string_view data;
+    std::size_t pos{};
+};
+} // namespace msgpack
+
 template <typename T> struct SerializableContainerHelper : std::false_type {};
 
 template <typename T> concept SerializableContainerType = SerializablePrimitive<T> || SerializableObject<T> ||
@@ -203,13 +429,101 @@ struct SerializableContainerHelper<std::unordered_map<P, C>> : std::true_type {}
 template <typename T> concept SerializableContainer = SerializableContainerHelper<T>::value;
 
 template <SerializableContainer C> class SerialContainer;
+
+namespace fingerprint {
+struct State;
+} // namespace fingerprint
 } // namespace detail
 
+class Codec {
+  public:
+    Codec()                        = default;
+    Codec(const Codec&)            = default;
+    Codec(Codec&&)                 = delete;
+    Codec& operator=(const Codec&) = default;
+    Codec& operator=(Codec&&)      = delete;
+    virtual ~Codec()               = default;
+
+    [[nodiscard]] virtual unsigned char id() const                                                             = 0;
+    [[nodiscard]] virtual std::string compress(std::string_view data) const                                    = 0;
+    [[nodiscard]] virtual std::optional<std::string> decompress(std::string_view data, std::size_t size) const = 0;
+};
+
+class LZCodec : public Codec {
+  public:
+    [[nodiscard]] unsigned char id() const override;
+    [[nodiscard]] std::string compress(std::string_view data) const override;
+    [[nodiscard]] std::optional<std::string> decompress(std::string_view data, std::size_t size) const override;
+};
+
+#if defined(SERIALIZABLE_ZLIB)
+class ZlibCodec : public Codec {
+  public:
+    [[nodiscard]] unsigned char id() const override;
+    [[nodiscard]] std::string compress(std::string_view data) const override;
+    [[nodiscard]] std::optional<std::string> decompress(std::string_view data, std::size_t size) const override;
+};
+#endif
+
+#if defined(SERIALIZABLE_ZSTD)
+class ZstdCodec : public Codec {
+  public:
+    [[nodiscard]] unsigned char id() const override;
+    [[nodiscard]] std::string compress(std::string_view data) const override;
+    [[nodiscard]] std::optional<std::string> decompress(std::string_view data, std::size_t size) const override;
+};
+#endif
+
+void registerCodec(std::shared_ptr<const Codec> codec);
+
+struct Options {
+    enum class Format { TEXT, JSON, MSGPACK };
+    enum class Checksum { NONE, CRC32C, XXHASH32 };
+
+    Format format   = Format::TEXT;         // Encoding of the data (text, JSON and MessagePack have no header)
+    bool compact    = false;                // Write text without indentation and spaces around equals signs
+    bool dictionary = false;                // Write repeated strings once and reference them by index
+    bool positional = false;                // Write MessagePack objects as arrays of members in exposure order
+    bool inlining   = false;                // Write small objects of primitives on a single line
+    bool sparse     = false;                // Omit values equal to their default (missing values are read as it)
+    bool validate   = false;                // Check that strings read are valid UTF-8 (Result::ENCODING otherwise)
+    bool bitfields  = false;                // Pack consecutive bools and enums of positional MessagePack into words
+    bool references = false;                // Write objects identical to an earlier one as a reference to its path
+    bool canonical  = false;                // Sort the keys of unordered maps, so equal state is written the same
+    std::shared_ptr<const Codec> codec;     // Compress saved files block by block (nullptr: uncompressed)
+    Checksum checksum     = Checksum::NONE; // Store a checksum of every block in saved files
+    std::size_t blockSize = 1 << 20;        // Uncompressed size of a block
+    unsigned int threads  = 0;              // Threads compressing blocks in parallel (0: one per hardware thread)
+    bool skipUnchanged    = false;          // Don't save files that already hold the data (compared by fingerprint)
+};
+
+// Largest value of an enum, specialize to pack it into fewer bits than its underlying type
+template <detail::Enum E> inline const constexpr std::optional<E> EnumMaximum = std::nullopt;
+
 class Serializable {
     friend class detail::SerialPointer; // Allows SerialPointer to access classID for typechecking
+    template <detail::SerializableContainer C> friend class detail::SerialContainer; // Allows packing elements
+    friend class TemporalEncoder;       // Allows collecting snapshots
+    friend class TemporalDecoder;       // Allows restoring snapshots
+    friend class SnapshotStore;         // Allows splitting snapshots into nested objects
+    friend class IncrementalSerializer; // Allows writing collected objects step by step
 
   public:
-    enum class Result { OK, FILE, STRUCTURE, INTEGRITY, TYPECHECK, POINTER };
+    enum class Result { OK, FILE, STRUCTURE, INTEGRITY, TYPECHECK, POINTER, CHECKSUM, ENCODING };
+    enum class Encoding { PLAIN, AUTO, DELTA, DELTA_OF_DELTA, FRAME_OF_REFERENCE, RUN_LENGTH, SPARSE };
+
+    // Lossy storage of floating point numbers (fixed point numbers of a scale and bit width, or half precision)
+    struct Quantization {
+        enum class Type { NONE, FIXED, HALF };
+
+        Type type         = Type::NONE;
+        double scale      = 0; // Distance between neighbouring fixed point numbers
+        unsigned int bits = 0; // Width of fixed point numbers including their sign (1 to 32)
+
+        [[nodiscard]] static Quantization fixed(double scale, unsigned int bits);
+        [[nodiscard]] static Quantization half();
+        [[nodiscard]] bool isValid() const;
+    };
 
     Serializable()                               = default;
     Serializable(const Serializable&)            = delete;
@@ -218,39 +532,331 @@ class Serializable {
     Serializable& operator=(Serializable&&)      = delete;
     virtual ~Serializable()                      = default;
 
-    [[nodiscard]] std::pair<Result, std::string> serialize();
-    [[nodiscard]] Result deserialize(const std::string& data);
-    [[nodiscard]] Result save(const std::filesystem::path& path);
-    [[nodiscard]] Result load(const std::filesystem::path& path);
+    [[nodiscard]] std::pair<Result, std::string> serialize(const Options& options = {});
+    [[nodiscard]] std::pair<Result, std::size_t> serialize(std::span<char> buffer, const Options& options = {});
+    [[nodiscard]] Result deserialize(std::string_view data, const Options& options = {});
+    [[nodiscard]] Result save(const std::filesystem::path& path, const Options& options = {});
+    [[nodiscard]] Result load(const std::filesystem::path& path, const Options& options = {});
+    [[nodiscard]] std::pair<Result, std::uint64_t> fingerprint();
 
   protected:
     virtual void exposed() = 0;
     [[nodiscard]] virtual unsigned int classID() const;
 
     template <detail::SerializablePrimitive P> void expose(const std::string& name, P& value);
+    template <detail::SerializablePrimitive P>
+    void expose(const std::string& name, P& value, const std::type_identity_t<P>& defaultValue);
     void expose(const std::string& name, Serializable& value);
     template <detail::SerializableObject P> void expose(const std::string& name, P*& value);
-    template <detail::SerializableContainer C> void expose(const std::string& name, C& value);
+    template <detail::SerializableContainer C>
+    void expose(const std::string& name, C& value, Encoding encoding = Encoding::PLAIN);
+    template <std::floating_point F> void expose(const std::string& name, F& value, Quantization quantization);
+    template <detail::SerializableContainer C>
+    void expose(const std::string& name, C& value, Quantization quantization);
 
   private:
-    enum class Mode { SERIALIZING, DESERIALIZING };
+    enum class Mode { SERIALIZING, DESERIALIZING, FINGERPRINTING };
+
+    [[nodiscard]] Result collect(const Options& options);
+    [[nodiscard]] std::pair<Result, std::string> encode(const Options& options);
+    [[nodiscard]] std::string prepareText(const Options& options);
+    [[nodiscard]] Result decode(Options::Format format, std::string_view data);
+    [[nodiscard]] Result parse(Options::Format format, std::string_view data);
+    [[nodiscard]] Result restore(std::unique_ptr<detail::Serial> root);
+    [[nodiscard]] Result decodeSerial();
+    [[nodiscard]] Result read(std::istream& stream);
+    [[nodiscard]] std::optional<detail::Serial*> find(const std::string& name);
+    template <detail::SerializablePrimitive P> void exposeBits(const std::string& name, P& value);
+
+    // Word of consecutive bools and enums packed into bit fields
+    struct Bits {
+        detail::SerialPrimitive* word{}; // Primitive the word is written to
+        std::size_t position{};          // Position after the primitive the word was read from
+        std::size_t count{};             // Words of the object
+        detail::packing::Word value{};
+        unsigned int used{};
+    };
 
     Mode mode{};
     Result result{};
+    Options::Format format{};
+    bool validate{};
+    bool sparse{};          // Values equal to the default given to expose are omitted
+    bool bitfields{};       // Bools and enums of positional objects are packed into words
+    bool canonical{};       // Keys of unordered maps are written sorted
+    bool legacy{};          // Strings are read with entities (text without version)
+    bool container{};       // Containers are read by index even if they are positional
+    std::size_t position{}; // Index of the next member of objects read positionally
     std::unique_ptr<detail::Serial> serial;
+    std::shared_ptr<const std::vector<std::string>> dictionary;
+    detail::fingerprint::State* hashing{}; // Hash state exposed values are fed into (when fingerprinting)
+    Bits bits;
 };
 
 namespace detail {
 template <SerializableContainer C> class SerialContainer : public Serializable {
   public:
-    explicit SerialContainer(C& value);
+    explicit SerialContainer(C& value, Encoding encoding = Encoding::PLAIN, Quantization quantization = {});
 
     void exposed() override;
 
   private:
     C* value;
+    Encoding encoding;
+    Quantization quantization;
+
+    void exposeElements();
+    void exposePacked();
+
+    static std::span<const Encoding> packings();
+    static std::string packedType(Encoding encoding);
+    static std::string quantizedType(Quantization::Type quantization);
+    static std::string encode(Encoding encoding, const C& values);
+    static std::optional<std::vector<typename C::value_type>> decode(Encoding encoding, const std::string& data);
+};
+
+std::map<unsigned char, std::shared_ptr<const Codec>>& codecs();
+std::mutex& codecsMutex();
+std::shared_ptr<const Codec> findCodec(unsigned char id);
+void parallelFor(std::size_t count, unsigned int threads, const std::function<void(std::size_t)>& task);
+
+namespace file {
+bool writeFile(const std::filesystem::path& path, std::string_view data);
+std::optional<std::string> readFile(const std::filesystem::path& path);
+} // namespace file
+
+namespace frame {
+inline const constexpr std::string_view MAGIC = "SRLZ";
+inline const constexpr unsigned char VERSION  = 1;
+inline const constexpr unsigned char BLOCKS   = 0x01; // Flag: data is stored in (compressed or checksummed) blocks
+
+struct Header {
+    unsigned char version{};
+    Options::Format format{};
+    unsigned char flags{};
+};
+
+// Fingerprint of the data and options a file was saved with, and the size and modification time the file had then
+struct Saved {
+    std::uint64_t fingerprint{};
+    std::uintmax_t size{};
+    std::filesystem::file_time_type time{};
+};
+
+// Files written by save in this process, by their absolute path
+struct SavedFiles {
+    std::mutex mutex;
+    std::unordered_map<std::string, Saved> files;
+};
+
+SavedFiles& savedFiles();
+std::uint64_t fingerprintData(std::string_view data, const Options& options);
+std::optional<bool> isSaved(const std::filesystem::path& path, std::uint64_t fingerprint);
+bool holdsFile(const std::filesystem::path& path, std::string_view file);
+void setSaved(const std::filesystem::path& path, std::uint64_t fingerprint);
+
+void writeInteger(std::ostream& stream, std::uint32_t value);
+std::optional<std::uint32_t> readInteger(std::istream& stream);
+std::string makeHeader(Options::Format format, unsigned char flags);
+bool hasHeader(Options::Format format);
+Options::Format detectFormat(std::string_view data);
+bool detect(std::istream& stream);
+std::optional<Header> readHeader(std::istream& stream);
+bool readSized(std::istream& stream, std::string& data, std::size_t size);
+std::uint32_t checksum(Options::Checksum checksum, std::string_view data);
+bool writeBlocks(std::ostream& stream, std::string_view data, const Options& options);
+bool writeData(std::ostream& stream, std::string_view data, const Options& options);
+std::pair<Serializable::Result, std::string> readBlocks(std::istream& stream, unsigned int threads = 0);
+Serializable::Result readBlocks(std::istream& stream, const std::function<void(std::string_view)>& consume,
+                                unsigned int threads = 0);
+
+// Writes blocks incrementally, buffering at most one batch of blocks (one block per thread)
+class BlockWriter {
+  public:
+    BlockWriter(std::ostream& stream, const Options& options);
+    BlockWriter(const BlockWriter&)            = delete;
+    BlockWriter(BlockWriter&&)                 = delete;
+    BlockWriter& operator=(const BlockWriter&) = delete;
+    BlockWriter& operator=(BlockWriter&&)      = delete;
+    ~BlockWriter()                             = default;
+
+    void write(std::string_view data);
+    bool finish();
+
+  private:
+    void writeBatch(std::string_view batch);
+
+    std::ostream& stream;
+    Options options;
+    std::size_t blockSize;
+    unsigned int threads;
+    std::string pending;
+    std::vector<std::string> blocks;
+    std::vector<std::uint32_t> checksums;
+};
+} // namespace frame
+
+namespace temporal {
+inline const constexpr char KEYFRAME = 'K'; // Frame tag: full text of the snapshot
+inline const constexpr char DELTA    = 'D'; // Frame tag: bits of every primitive compressed against the previous one
+
+enum class Kind { SIGNED, UNSIGNED, FLOAT, DOUBLE, RAW };
+
+// State of a primitive carried from one snapshot to the next
+struct Field {
+    Kind kind{};
+    packing::Word value{};              // Bits of the previous number (integers sign extended)
+    packing::Word delta{};              // Difference between the previous two integers
+    unsigned int leading{}, trailing{}; // Meaningful bits of the previous float XOR (if there is one)
+    bool window{};
+    std::string text; // Previous value of other primitives
+};
+
+// Writes bits most significant first
+class BitWriter {
+  public:
+    void write(packing::Word value, unsigned int bits);
+    [[nodiscard]] std::string finish();
+
+  private:
+    std::string data;
+    unsigned int used{}; // Bits used in the last byte
+};
+
+// Reads bits written by a BitWriter
+class BitReader {
+  public:
+    explicit BitReader(std::string_view data);
+
+    [[nodiscard]] std::optional<packing::Word> read(unsigned int bits);
+    [[nodiscard]] bool finished() const;
+
+  private:
+    std::string_view data;
+    std::size_t pos{}; // Bits read
+};
+
+Field makeField(const std::string& type, const std::string& value);
+std::optional<packing::Word> parseBits(Kind kind, const std::string& value);
+std::string formatBits(Kind kind, packing::Word bits);
+bool encodeField(BitWriter& writer, Field& field, const std::string& value);
+std::optional<std::string> decodeField(BitReader& reader, Field& field);
+} // namespace temporal
+
+namespace fingerprint {
+// Tags starting the entries of exposed values, objects and pointers and ending objects
+inline const constexpr char VALUE   = 'V';
+inline const constexpr char OBJECT  = 'O';
+inline const constexpr char POINTER = 'P';
+inline const constexpr char END     = 'E';
+
+// Size of the blocks small pieces of data are collected into before hashing them
+inline const constexpr std::size_t BLOCK_SIZE = 4096;
+
+// Hashes data fed in pieces (xxHash64 of blocks, each seeded with the hash of the blocks before)
+class Hasher {
+  public:
+    void update(std::string_view data);
+    void updateString(std::string_view str);
+    template <typename T> void updateValue(const T& value);
+    [[nodiscard]] std::uint64_t digest();
+
+  private:
+    std::string buffer;
+    std::uint64_t hash{};
+
+    void flush();
+};
+
+// State shared by the objects of one fingerprint
+struct State {
+    Hasher hasher;
+    std::unordered_map<Address, Address> addresses; // Virtual addresses of objects with class id (by real address)
+    std::vector<Address> targets;                   // Real addresses pointers point to (in exposure order)
 };
+} // namespace fingerprint
+
+namespace store {
+inline const constexpr auto SUBTREE = "SUBTREE"; // Type of primitives referring to a stored object by its hash
+inline const constexpr auto OBJECT  = "object";  // Name of stored objects (their names are kept in the manifest)
+
+std::string hashName(std::uint64_t hash);
+bool isFileName(std::string_view name);
+} // namespace store
 } // namespace detail
+
+// Compresses snapshots of an object taken over time against the previous one (integers by their delta of delta,
+// floats by the XOR of their bits), writing the full text as keyframe periodically or when the structure changes
+class TemporalEncoder {
+  public:
+    explicit TemporalEncoder(Serializable& object, std::size_t keyframeInterval = 64);
+
+    [[nodiscard]] std::pair<Serializable::Result, std::string> encode();
+
+  private:
+    Serializable* object;
+    std::size_t keyframeInterval; // Frames from one keyframe to the next (0: only when the structure changes)
+    std::size_t frames{};         // Frames since the last keyframe
+    std::optional<std::string> structure;
+    std::vector<detail::temporal::Field> fields;
+};
+
+// Restores snapshots written by a TemporalEncoder into an object (frames have to be decoded in order)
+class TemporalDecoder {
+  public:
+    explicit TemporalDecoder(Serializable& object);
+
+    [[nodiscard]] Serializable::Result decode(std::string_view frame);
+
+  private:
+    Serializable* object;
+    std::unique_ptr<detail::Serial> previous; // Previous snapshot with virtual addresses
+    std::vector<detail::SerialPrimitive*> primitives;
+    std::vector<detail::temporal::Field> fields;
+};
+
+// Stores snapshots of objects in a directory, every nested object once under the hash of its content (snapshots are
+// manifests referring to the hashes of their nested objects, so a new snapshot only adds the objects that changed)
+class SnapshotStore {
+  public:
+    explicit SnapshotStore(std::filesystem::path directory);
+
+    [[nodiscard]] Serializable::Result save(Serializable& object, const std::string& name) const;
+    [[nodiscard]] Serializable::Result load(Serializable& object, const std::string& name) const;
+
+  private:
+    std::filesystem::path directory;
+};
+
+// Writes the text of an object in steps of bounded work, so large objects don't block a loop for long. The first step
+// runs the exposers (which can not be interrupted) and takes the collected tree, later steps write it node by node
+// (other formats are written completely in the first step).
+class IncrementalSerializer {
+  public:
+    explicit IncrementalSerializer(Serializable& object, Options options = {});
+
+    [[nodiscard]] bool step(std::size_t nodes);
+    [[nodiscard]] bool step(std::chrono::steady_clock::duration time);
+    [[nodiscard]] bool finished() const;
+    [[nodiscard]] std::pair<Serializable::Result, std::string> finish();
+
+  private:
+    // Children of an object being written
+    struct Frame {
+        std::vector<const detail::Serial*> children;
+        std::size_t next{};
+    };
+
+    Serializable* object;
+    Options options;
+    Serializable::Result result = Serializable::Result::OK;
+    std::string data;
+    std::unique_ptr<detail::Serial> root; // Collected tree (owned, so the object may be used between steps)
+    std::vector<Frame> stack;             // Objects being written (the first frame holds the root)
+    bool started{}, done{};
+
+    bool run(const std::function<bool()>& exhausted);
+};
 } // namespace serializable
 
 namespace serializable {
@@ -264,7 +870,10 @@ inline SerialPointer* Serial::asPointer() { return dynamic_cast<SerialPointer*>(
 inline SerialPrimitive::SerialPrimitive(std::string type, std::string name, std::string value)
     : type(std::move(type)), name(std::move(name)), value(std::move(value)) {}
 
-inline std::string SerialPrimitive::get() const { return string::makeString(type, " ", name, " = ", value); }
+inline std::string SerialPrimitive::get(bool compact, bool /*inlining*/) const {
+    const std::string equals = compact ? "=" : " = ";
+    return string::makeString(type, " ", name, equals, value);
+}
 
 inline bool SerialPrimitive::set(const std::string& data) {
     // Parse data
@@ -279,6 +888,46 @@ inline bool SerialPrimitive::set(const std::string& data) {
     return true;
 }
 
+inline void SerialPrimitive::getJSON(std::string& data) const {
+    // Write strings and values that are not JSON numbers (like nan or inf) as JSON strings
+    if(type == string::TypeToString<std::string>) {
+        const auto str = string::deserializePrimitive<std::string>(value);
+        json::writeString(data, str ? str.value() : value);
+    } else if(type == string::TypeToString<bool> || json::isNumber(value)) data.append(value);
+    else json::writeString(data, value);
+}
+
+inline void SerialPrimitive::getMsgPack(msgpack::Writer& writer, bool /*positional*/) const {
+    // Write strings, booleans and numbers as native types
+    if(type == string::TypeToString<std::string>) {
+        const auto str = string::deserializePrimitive<std::string>(value);
+        writer.writeString(str ? str.value() : value);
+        return;
+    }
+    if(type == string::TypeToString<bool>) {
+        writer.writeBool(value == "true");
+        return;
+    }
+    if(type == string::TypeToString<float>) {
+        const auto number = string::deserializePrimitive<float>(value);
+        if(number) return writer.writeFloat(number.value());
+    } else if(type == string::TypeToString<double>) {
+        const auto number = string::deserializePrimitive<double>(value);
+        if(number) return writer.writeDouble(number.value());
+    } else if(type == string::TypeToString<char> || type == string::TypeToString<short> ||
+              type == string::TypeToString<int> || type == string::TypeToString<long>) {
+        const auto number = string::deserializePrimitive<long>(value);
+        if(number) return writer.writeInteger(number.value());
+    } else if(type == string::TypeToString<unsigned char> || type == string::TypeToString<unsigned int> ||
+              type == string::TypeToString<unsigned long> || type == "ENUM") {
+        const auto number = string::deserializePrimitive<unsigned long>(value);
+        if(number) return writer.writeUnsigned(number.value());
+    }
+
+    // Write anything else (like values that don't match their type) as string
+    writer.writeString(value);
+}
+
 inline std::string SerialPrimitive::getName() const { return name; }
 
 inline std::unique_ptr<Serial> SerialPrimitive::clone() const {
@@ -289,21 +938,62 @@ inline std::string SerialPrimitive::getType() const { return type; }
 
 inline std::string SerialPrimitive::getValue() const { return value; }
 
+inline void SerialPrimitive::setValue(std::string value) { this->value = std::move(value); }
+
 inline SerialObject::SerialObject(unsigned int classID, std::string name, Address realAddress, Address virtualAddress)
     : name(std::move(name)), classID(classID), realAddress(realAddress), virtualAddress(virtualAddress) {}
 
-inline std::string SerialObject::get() const {
-    // Collect children data
+inline std::string SerialObject::get(bool compact, bool inlining) const {
+    // Write small objects of primitives on a single line
+    if(inlining) {
+        auto line = getInline(compact);
+        if(line) return std::move(line.value());
+    }
+
+    // Collect children data (in exposure order, so equal objects are always written the same)
     std::vector<std::string> children;
     children.reserve(this->children.size());
-    for(const auto& [_, child] : this->children) children.push_back(child->get());
+    for(const auto& childName : order) children.push_back(this->children.at(childName)->get(compact, inlining));
 
-    // Connect and indent children data
-    std::string childrenData = string::indent(string::connect(children));
+    // Connect and indent children data (compact data is not indented)
+    std::string childrenData = string::connect(children);
+    if(!compact) childrenData = string::indent(childrenData);
 
     // Return object data string
-    return string::makeString("OBJECT<", string::serializePrimitive(classID), "> ", name, " = ",
-                              string::serializePrimitive(virtualAddress), " {\n", childrenData, "\n}");
+    const std::string opening = compact ? "{\n" : " {\n";
+    return string::makeString(getHeader(compact), opening, childrenData, "\n}");
+}
+
+inline std::string SerialObject::getHeader(bool compact) const {
+    const std::string equals = compact ? "=" : " = ";
+    return string::makeString("OBJECT<", string::serializePrimitive(classID), "> ", name, equals,
+                              string::serializePrimitive(virtualAddress));
+}
+
+inline std::optional<std::string> SerialObject::getInline(bool compact) const {
+    // Only objects of primitives whose children contain no separators and fit the line are inlined
+    if(order.empty()) return std::nullopt;
+    const std::string separator = compact ? ";" : "; ";
+    std::string line;
+    for(const auto& childName : order) {
+        const Serial* child = children.at(childName).get();
+        if(dynamic_cast<const SerialPrimitive*>(child) == nullptr) return std::nullopt;
+        const std::string data = child->get(compact);
+        if(data.find_first_of("\n{};") != std::string::npos) return std::nullopt;
+        line.append(line.empty() ? "" : separator).append(data);
+        if(line.size() > string::INLINE_SIZE) return std::nullopt;
+    }
+
+    const std::string opening = compact ? "{" : " { ";
+    const std::string closing = compact ? "}" : " }";
+    return string::makeString(getHeader(compact), opening, line, closing);
+}
+
+inline std::vector<const Serial*> SerialObject::getChildren() const {
+    std::vector<const Serial*> result;
+    result.reserve(order.size());
+    for(const auto& childName : order) result.push_back(children.at(childName).get());
+    return result;
 }
 
 inline bool SerialObject::set(const std::string& data) {
@@ -322,10 +1012,18 @@ inline bool SerialObject::set(const std::string& data) {
     name           = parsed->at(1);
     virtualAddress = parsedVirtualAddress.value();
     children.clear();
+    order.clear();
 
-    // Parse children
-    const std::vector<std::string> children = string::split(string::unindent(parsed->at(3)));
-    for(const auto& child : children) {
+    // Parse children (compact data is not indented, its header has no spaces around the equals sign, inline children
+    // are separated by semicolons)
+    const std::size_t opening = data.find('{', data.find('='));
+    const bool compact        = data.substr(0, opening).find(" = ") == std::string::npos;
+    const bool inlined        = data.find('\n', opening) == std::string::npos;
+    std::vector<std::string> children;
+    if(inlined) children = string::split(parsed->at(3), ';');
+    else children = string::split(compact ? parsed->at(3) : string::unindent(parsed->at(3)));
+    for(auto& child : children) {
+        if(inlined && !compact && child.starts_with(' ')) child.erase(0, 1);
         if(child.empty()) continue;
         if(child.starts_with("OBJECT")) {
             auto object = std::make_unique<SerialObject>();
@@ -345,11 +1043,98 @@ inline bool SerialObject::set(const std::string& data) {
     return true;
 }
 
+inline void SerialObject::getJSON(std::string& data) const {
+    // Write containers as arrays
+    const auto elements = getElements();
+    if(elements) {
+        data.push_back('[');
+        for(const auto* element : elements.value()) {
+            element->getJSON(data);
+            data.push_back(',');
+        }
+        if(data.back() == ',') data.pop_back();
+        data.push_back(']');
+        return;
+    }
+
+    // Write maps as objects with their keys as names, other objects with their class id and address (if any)
+    data.push_back('{');
+    const auto entries = getEntries();
+    if(entries) {
+        for(const auto& [key, value] : entries.value()) {
+            json::writeString(data, key);
+            data.push_back(':');
+            value->getJSON(data);
+            data.push_back(',');
+        }
+    } else {
+        if(classID != 0)
+            data.append(string::makeString("\"$class\":", string::serializePrimitive(classID), ",\"$id\":",
+                                           string::serializePrimitive(virtualAddress), ","));
+        for(const auto& childName : order) {
+            json::writeString(data, childName);
+            data.push_back(':');
+            children.at(childName)->getJSON(data);
+            data.push_back(',');
+        }
+    }
+    if(data.back() == ',') data.pop_back();
+    data.push_back('}');
+}
+
+inline void SerialObject::getMsgPack(msgpack::Writer& writer, bool positional) const {
+    // Write containers as arrays
+    const auto elements = getElements();
+    if(elements) {
+        writer.writeArray(elements->size());
+        for(const auto* element : elements.value()) element->getMsgPack(writer, positional);
+        return;
+    }
+
+    // Write maps as maps with their keys as names
+    const auto entries = getEntries();
+    if(entries) {
+        writer.writeMap(entries->size());
+        for(const auto& [key, value] : entries.value()) {
+            writer.writeString(key);
+            value->getMsgPack(writer, positional);
+        }
+        return;
+    }
+
+    // Write other objects as arrays of their members in exposure order (positional) or as maps with their names,
+    // both starting with their class id and address (if any)
+    const std::size_t header = classID != 0 ? 2 : 0;
+    if(positional) {
+        writer.writeArray(header + order.size());
+        if(classID != 0) {
+            writer.writeUnsigned(classID);
+            writer.writeUnsigned(virtualAddress);
+        }
+        for(const auto& childName : order) children.at(childName)->getMsgPack(writer, positional);
+        return;
+    }
+
+    writer.writeMap(header + order.size());
+    if(classID != 0) {
+        writer.writeString("$class");
+        writer.writeUnsigned(classID);
+        writer.writeString("$id");
+        writer.writeUnsigned(virtualAddress);
+    }
+    for(const auto& childName : order) {
+        writer.writeString(childName);
+        children.at(childName)->getMsgPack(writer, positional);
+    }
+}
+
 inline std::string SerialObject::getName() const { return name; }
 
 inline std::unique_ptr<Serial> SerialObject::clone() const {
-    auto clone = std::make_unique<SerialObject>(classID, name, realAddress, virtualAddress);
-    for(const auto& [_, child] : children) clone->append(child->clone());
+    auto clone        = std::make_unique<SerialObject>(classID, name, realAddress, virtualAddress);
+    clone->positional = positional;
+    clone->container  = container;
+    for(const auto& childName : order) clone->append(children.at(childName)->clone());
     return clone;
 }
 
@@ -360,7 +1145,12 @@ inline void SerialObject::emplace(unsigned int classID, std::string name, Addres
     this->virtualAddress = virtualAddress;
 }
 
-inline void SerialObject::append(std::unique_ptr<Serial> child) { children[child->getName()] = std::move(child); }
+inline void SerialObject::append(std::unique_ptr<Serial> child) {
+    // Remember order of new names (appending an existing name replaces the child)
+    auto& slot = children[child->getName()];
+    if(!slot) order.push_back(child->getName());
+    slot = std::move(child);
+}
 
 inline std::optional<Serial*> SerialObject::getChild(const std::string& name) const {
     // Check if name exists and return
@@ -368,8 +1158,47 @@ inline std::optional<Serial*> SerialObject::getChild(const std::string& name) co
     return children.at(name).get();
 }
 
+inline const Serial* SerialObject::getLast() const { return order.empty() ? nullptr : children.at(order.back()).get(); }
+
+inline void SerialObject::replace(const std::function<std::unique_ptr<Serial>(Serial&)>& replacement) {
+    // Replace children by what the function returns for them (keeping those it returns nullptr for)
+    for(auto& [_, child] : children)
+        if(auto replaced = replacement(*child)) child = std::move(replaced);
+}
+
 inline unsigned int SerialObject::getClass() const { return classID; }
 
+inline Address SerialObject::getVirtualAddress() const { return virtualAddress; }
+
+inline bool SerialObject::isPositional() const { return positional; }
+
+inline void SerialObject::setPositional(bool positional) { this->positional = positional; }
+
+inline bool SerialObject::isContainer() const { return container; }
+
+inline void SerialObject::setContainer(bool container) { this->container = container; }
+
+inline std::size_t SerialObject::resolvePosition(unsigned int expectedClassID) {
+    // Positional objects with class id store it and their address in their first two elements
+    if(!positional || expectedClassID == 0) return 0;
+    const auto number = [this](const std::string& index) -> std::optional<unsigned long> {
+        const auto child = children.find(index);
+        if(child == children.end() || child->second->asPrimitive() == nullptr) return std::nullopt;
+        const auto* primitive = child->second->asPrimitive();
+        const auto value      = json::typedValue<unsigned long>(primitive->getType(), primitive->getValue());
+        return value ? string::deserializePrimitive<unsigned long>(value.value()) : std::nullopt;
+    };
+
+    // Take class id and address (leaving class id 0 fails the class check)
+    const auto parsedClassID = number("0");
+    const auto parsedAddress = number("1");
+    if(!parsedClassID || !parsedAddress || parsedClassID.value() > UINT_MAX) return 0;
+    classID        = static_cast<unsigned int>(parsedClassID.value());
+    virtualAddress = parsedAddress.value();
+
+    return 2;
+}
+
 inline void SerialObject::virtualizeAddresses(std::unordered_map<Address, Address>& addressMap) {
     // Reset own virtual address
     virtualAddress = 0;
@@ -385,9 +1214,9 @@ inline void SerialObject::virtualizeAddresses(std::unordered_map<Address, Addres
     // Register in address map
     addressMap[realAddress] = virtualAddress;
 
-    // Apply to all children objects
-    for(auto& [_, child] : children) {
-        SerialObject* object = child->asObject();
+    // Apply to all children objects (in exposure order, so equal trees get the same addresses)
+    for(const auto& childName : order) {
+        SerialObject* object = children.at(childName)->asObject();
         if(object != nullptr) object->virtualizeAddresses(addressMap);
     }
 }
@@ -436,14 +1265,183 @@ inline bool SerialObject::restorePointers(const std::unordered_map<Address, Addr
 
 inline void SerialObject::setRealAddress(Address address) { realAddress = address; }
 
+inline void SerialObject::countStrings(std::unordered_map<std::string, std::size_t>& counts) const {
+    for(const auto& [_, child] : children) {
+        // Count string primitives
+        SerialPrimitive* primitive = child->asPrimitive();
+        if(primitive != nullptr && primitive->getType() == string::TypeToString<std::string>)
+            counts[primitive->getValue()]++;
+
+        // Apply to all children objects
+        SerialObject* object = child->asObject();
+        if(object != nullptr) object->countStrings(counts);
+    }
+}
+
+inline std::optional<std::vector<const Serial*>> SerialObject::getElements() const {
+    // Only objects collected from containers are written as arrays (members of objects could look like elements)
+    if(!container) return std::nullopt;
+
+    // Check size (only containers that can be resized store their size)
+    std::size_t count = children.size();
+    const auto size   = children.find("size");
+    if(size != children.end()) {
+        const SerialPrimitive* primitive = size->second->asPrimitive();
+        if(primitive == nullptr || primitive->getType() != string::TypeToString<std::size_t>) return std::nullopt;
+        if(primitive->getValue() != string::serializePrimitive(--count)) return std::nullopt;
+    } else if(count == 0) return std::nullopt;
+
+    // Collect elements named by their index
+    std::vector<const Serial*> elements;
+    elements.reserve(count);
+    for(std::size_t index = 0; index < count; index++) {
+        const auto element = children.find(string::serializePrimitive(index));
+        if(element == children.end()) return std::nullopt;
+        elements.push_back(element->second.get());
+    }
+
+    return elements;
+}
+
+inline std::optional<std::vector<std::pair<std::string, const Serial*>>> SerialObject::getEntries() const {
+    // Maps are containers with a list of keys
+    if(!container) return std::nullopt;
+    const auto keys = children.find("keys");
+    if(keys == children.end() || keys->second->asObject() == nullptr) return std::nullopt;
+    const auto elements = keys->second->asObject()->getElements();
+    if(!elements || elements->size() + 1 != children.size()) return std::nullopt;
+
+    // Collect entries in the order of the keys
+    std::vector<std::pair<std::string, const Serial*>> entries;
+    entries.reserve(elements->size());
+    for(const Serial* element : elements.value()) {
+        const auto* primitive = dynamic_cast<const SerialPrimitive*>(element);
+        if(primitive == nullptr || primitive->getType() != string::TypeToString<std::string>) return std::nullopt;
+        const auto key = string::deserializePrimitive<std::string>(primitive->getValue());
+        if(!key) return std::nullopt;
+
+        const auto value = children.find(key.value());
+        if(value == children.end()) return std::nullopt;
+        entries.emplace_back(key.value(), value->second.get());
+    }
+
+    return entries;
+}
+
+inline void SerialObject::referenceStrings(const std::unordered_map<std::string, std::size_t>& dictionary) {
+    for(auto& [_, child] : children) {
+        // Replace string primitives found in the dictionary with their index
+        SerialPrimitive* primitive = child->asPrimitive();
+        if(primitive != nullptr && primitive->getType() == string::TypeToString<std::string>) {
+            const auto entry = dictionary.find(primitive->getValue());
+            if(entry != dictionary.end()) primitive->setValue("@" + string::serializePrimitive(entry->second));
+        }
+
+        // Apply to all children objects
+        SerialObject* object = child->asObject();
+        if(object != nullptr) object->referenceStrings(dictionary);
+    }
+}
+
+inline void SerialObject::outline(std::string& structure, std::vector<SerialPrimitive*>& primitives) {
+    structure.append(string::makeString("OBJECT<", string::serializePrimitive(classID), "> ", name, " = ",
+                                        string::serializePrimitive(virtualAddress), " {\n"));
+
+    // Visit children sorted by name, so trees built in a different order have the same outline
+    std::vector<const std::string*> names;
+    names.reserve(order.size());
+    for(const auto& childName : order) names.push_back(&childName);
+    std::sort(names.begin(), names.end(), [](const auto* a, const auto* b) { return *a < *b; });
+
+    // Describe everything but the values of primitives, collect primitives instead
+    for(const auto* childName : names) {
+        Serial* child = children.at(*childName).get();
+        if(SerialPrimitive* primitive = child->asPrimitive(); primitive != nullptr) {
+            structure.append(string::makeString(primitive->getType(), " ", *childName, "\n"));
+            primitives.push_back(primitive);
+        } else if(SerialObject* object = child->asObject(); object != nullptr) object->outline(structure, primitives);
+        else structure.append(child->get()).append("\n");
+    }
+    structure.append("}\n");
+}
+
+inline void SerialObject::rename(std::string name) { this->name = std::move(name); }
+
+inline std::size_t SerialObject::referenceObjects(
+    std::unordered_map<std::string, std::pair<std::size_t, std::string>>& originals, const std::string& path,
+    std::string& key) {
+    // Describe the object by its class, address and children (nested objects by the index of their first occurrence)
+    key = string::makeString(string::serializePrimitive(classID), " ", string::serializePrimitive(virtualAddress));
+    std::size_t size = key.size() + name.size() + 16;
+    for(const auto& childName : order) {
+        auto& child          = children.at(childName);
+        SerialObject* object = child->asObject();
+        if(object == nullptr) {
+            const std::string data = child->get();
+            key.append("\n").append(data);
+            size += data.size() + 2;
+            continue;
+        }
+
+        // Describe nested objects first, replacing those identical to one visited before by its path (if shorter)
+        const std::string quoted    = string::serializePrimitive(childName);
+        const std::string childPath = path.empty() ? quoted : string::makeString(path, " ", quoted);
+        std::string childKey;
+        const std::size_t childSize     = object->referenceObjects(originals, childPath, childKey);
+        const auto [original, inserted] = originals.try_emplace(std::move(childKey), originals.size(), childPath);
+        const auto& [index, originalPath] = original->second;
+        const std::size_t referenceSize   = childName.size() + originalPath.size() + 8;
+        if(!inserted && referenceSize < childSize) {
+            child = std::make_unique<SerialPrimitive>(string::REFERENCE, childName, originalPath);
+            size += referenceSize;
+        } else size += childSize;
+        key.append("\n").append(quoted).append(" #").append(string::serializePrimitive(index));
+    }
+    return size;
+}
+
+inline bool SerialObject::resolveReferences(SerialObject& root, std::unordered_set<const SerialObject*>& resolving) {
+    resolving.insert(this);
+    for(auto& [childName, child] : children) {
+        if(SerialObject* object = child->asObject(); object != nullptr) {
+            if(!object->resolveReferences(root, resolving)) return false;
+            continue;
+        }
+        const SerialPrimitive* primitive = child->asPrimitive();
+        if(primitive == nullptr || primitive->getType() != string::REFERENCE) continue;
+
+        // Follow the path from the root
+        const auto path = string::parsePath(primitive->getValue());
+        if(!path) return false;
+        SerialObject* target = &root;
+        for(const auto& targetName : path.value()) {
+            const auto next = target->getChild(targetName);
+            target          = next ? next.value()->asObject() : nullptr;
+            if(target == nullptr) return false;
+        }
+
+        // Replace the reference by a copy of its target (resolved first, it can not contain the reference itself)
+        if(resolving.contains(target) || !target->resolveReferences(root, resolving)) return false;
+        auto copy = target->clone();
+        copy->asObject()->rename(childName);
+        child = std::move(copy);
+    }
+    resolving.erase(this);
+    return true;
+}
+
 inline SerialPointer::SerialPointer(unsigned int classID, std::string name, void** location)
     : name(std::move(name)), classID(classID), location(location) {
     if(location != nullptr) address = std::bit_cast<Address>(*location);
 }
 
-inline std::string SerialPointer::get() const {
+inline SerialPointer::SerialPointer(unsigned int classID, std::string name, Address address)
+    : name(std::move(name)), classID(classID), address(address) {}
+
+inline std::string SerialPointer::get(bool compact, bool /*inlining*/) const {
     // Return pointer data string
-    return string::makeString("PTR<", string::serializePrimitive(classID), "> ", name, " = ",
+    const std::string equals = compact ? "=" : " = ";
+    return string::makeString("PTR<", string::serializePrimitive(classID), "> ", name, equals,
                               string::serializePrimitive(address));
 }
 
@@ -466,6 +1464,20 @@ inline bool SerialPointer::set(const std::string& data) {
     return true;
 }
 
+inline void SerialPointer::getJSON(std::string& data) const {
+    data.append(string::makeString("{\"$class\":", string::serializePrimitive(classID), ",\"$ref\":",
+                                   string::serializePrimitive(address), "}"));
+}
+
+inline void SerialPointer::getMsgPack(msgpack::Writer& writer, bool /*positional*/) const {
+    // Write pointers as maps (even in positional mode, where maps can't be confused with objects)
+    writer.writeMap(2);
+    writer.writeString("$class");
+    writer.writeUnsigned(classID);
+    writer.writeString("$ref");
+    writer.writeUnsigned(address);
+}
+
 inline std::string SerialPointer::getName() const { return name; }
 
 inline std::unique_ptr<Serial> SerialPointer::clone() const {
@@ -618,12 +1630,123 @@ inline std::string unindent(const std::string& data) {
     return replaceAll(data.substr(1), "\n\t", "\n");
 }
 
+inline std::string encodeBase64(const std::vector<unsigned char>& bytes) {
+    static const constexpr auto alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Create new string (no padding, the length is implied by the data)
+    std::string str;
+    str.reserve((bytes.size() * 4 + 2) / 3);
+
+    // Encode groups of three bytes as four characters
+    for(std::size_t i = 0; i < bytes.size(); i += 3) {
+        const std::size_t count = std::min<std::size_t>(3, bytes.size() - i);
+        unsigned int group      = 0;
+        for(std::size_t j = 0; j < 3; j++) group = (group << 8) | (j < count ? bytes[i + j] : 0);
+        for(std::size_t j = 0; j <= count; j++) str.push_back(alphabet[(group >> (18 - 6 * j)) & 0x3F]);
+    }
+
+    return str;
+}
+
+inline std::optional<std::vector<unsigned char>> decodeBase64(const std::string& str) {
+    // A single trailing character can not encode a full byte
+    if(str.size() % 4 == 1) return std::nullopt;
+
+    // Create vector
+    std::vector<unsigned char> bytes;
+    bytes.reserve(str.size() * 3 / 4);
+
+    // Decode groups of four characters to three bytes
+    for(std::size_t i = 0; i < str.size(); i += 4) {
+        const std::size_t count = std::min<std::size_t>(4, str.size() - i);
+        unsigned int group      = 0;
+        for(std::size_t j = 0; j < 4; j++) {
+            unsigned int sextet = 0;
+            if(j < count) {
+                const char c = str[i + j];
+                if(c >= 'A' && c <= 'Z') sextet = c - 'A';
+                else if(c >= 'a' && c <= 'z') sextet = c - 'a' + 26;
+                else if(c >= '0' && c <= '9') sextet = c - '0' + 52;
+                else if(c == '+') sextet = 62;
+                else if(c == '/') sextet = 63;
+                else return std::nullopt;
+            }
+            group = (group << 6) | sextet;
+        }
+        for(std::size_t j = 0; j + 1 < count; j++) bytes.push_back((group >> (16 - 8 * j)) & 0xFF);
+    }
+
+    return bytes;
+}
+
+inline bool isUTF8(std::string_view str) {
+    std::size_t pos = 0;
+    while(pos < str.size()) {
+#if defined(__SSE2__)
+        // Skip 16 ASCII characters at a time (none has its high bit set)
+        for(; pos + sizeof(__m128i) <= str.size(); pos += sizeof(__m128i)) {
+            const __m128i chunk = _mm_loadu_si128(std::bit_cast<const __m128i*>(str.data() + pos));
+            const auto mask     = static_cast<unsigned int>(_mm_movemask_epi8(chunk));
+            if(mask != 0) {
+                pos += std::countr_zero(mask);
+                break;
+            }
+        }
+        if(pos >= str.size()) break;
+#endif
+
+        // Find length and range of the second byte of the next character (excluding overlong encodings, surrogates
+        // and code points above U+10FFFF)
+        const auto lead    = static_cast<unsigned char>(str[pos]);
+        std::size_t length = 0;
+        unsigned char low = 0x80, high = 0xBF;
+        if(lead < 0x80) length = 1;
+        else if(lead >= 0xC2 && lead <= 0xDF) length = 2;
+        else if(lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            if(lead == 0xE0) low = 0xA0;
+            if(lead == 0xED) high = 0x9F;
+        } else if(lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            if(lead == 0xF0) low = 0x90;
+            if(lead == 0xF4) high = 0x8F;
+        } else return false;
+        if(str.size() - pos < length) return false;
+
+        // Check continuation bytes
+        for(std::size_t i = 1; i < length; i++) {
+            const auto byte = static_cast<unsigned char>(str[pos + i]);
+            if(byte < (i == 1 ? low : 0x80) || byte > (i == 1 ? high : 0xBF)) return false;
+        }
+        pos += length;
+    }
+
+    return true;
+}
+
 template <> inline std::string serializePrimitive<bool>(const bool& val) { return val ? "true" : "false"; }
 
 template <> inline std::string serializePrimitive<std::string>(const std::string& val) {
-    std::string safe = replaceAll(val, "\"", "&quot;");
-    safe             = replaceAll(safe, "\n", "&newline;");
-    return makeString("\"", safe, "\"");
+    // Quote strings without special characters directly
+    std::string safe;
+    safe.reserve(val.size() + 2);
+    safe.push_back('"');
+    std::size_t pos = val.find_first_of("\"\n\\");
+    if(pos == std::string::npos) return safe.append(val).append("\"");
+
+    // Escape quotes, newlines and backslashes in a single pass
+    safe.append(val, 0, pos);
+    for(; pos < val.size(); pos++) {
+        switch(const char c = val[pos]) {
+            case '"': safe.append("\\\""); break;
+            case '\n': safe.append("\\n"); break;
+            case '\\': safe.append("\\\\"); break;
+            default: safe.push_back(c);
+        }
+    }
+
+    safe.push_back('"');
+    return safe;
 }
 
 template <Enum E> std::string serializePrimitive(const E& val) {
@@ -681,35 +1804,62 @@ template <> inline std::optional<unsigned int> deserializePrimitive<unsigned int
 }
 
 template <> inline std::optional<long> deserializePrimitive<long>(const std::string& str) {
-    try {
-        return std::stol(str);
-    } catch(const std::exception& e) { return std::nullopt; }
+    long value              = 0;
+    const auto [end, error] = packing::parseInteger(str, value);
+    if(error != std::errc() || end != str.data() + str.size()) return std::nullopt; // NOLINT(*-pointer-arithmetic)
+    return value;
 }
 
 template <> inline std::optional<unsigned long> deserializePrimitive<unsigned long>(const std::string& str) {
-    if(str.starts_with("-")) return std::nullopt;
-    try {
-        return std::stoul(str);
-    } catch(const std::exception& e) { return std::nullopt; }
+    unsigned long value     = 0;
+    const auto [end, error] = packing::parseInteger(str, value);
+    if(error != std::errc() || end != str.data() + str.size()) return std::nullopt; // NOLINT(*-pointer-arithmetic)
+    return value;
 }
 
 template <> inline std::optional<float> deserializePrimitive<float>(const std::string& str) {
-    try {
-        return std::stof(str);
-    } catch(const std::exception& e) { return std::nullopt; }
+    float value             = 0;
+    const auto [end, error] = packing::parseFloat(str, value);
+    if(error != std::errc() || end != str.data() + str.size()) return std::nullopt; // NOLINT(*-pointer-arithmetic)
+    return value;
 }
 
 template <> inline std::optional<double> deserializePrimitive<double>(const std::string& str) {
-    try {
-        return std::stod(str);
-    } catch(const std::exception& e) { return std::nullopt; }
+    double value            = 0;
+    const auto [end, error] = packing::parseFloat(str, value);
+    if(error != std::errc() || end != str.data() + str.size()) return std::nullopt; // NOLINT(*-pointer-arithmetic)
+    return value;
 }
 
 template <> inline std::optional<std::string> deserializePrimitive<std::string>(const std::string& str) {
-    if(!str.starts_with('"') || !str.ends_with('"')) return std::nullopt;
-    std::string unsafe = substring(str, 1, str.size() - 1);
-    unsafe             = replaceAll(unsafe, "&newline;", "\n");
-    return replaceAll(unsafe, "&quot;", "\"");
+    if(str.size() < 2 || !str.starts_with('"') || !str.ends_with('"')) return std::nullopt;
+
+    // Use strings without escape sequences directly
+    std::size_t pos = str.find_first_of("\"\\", 1);
+    if(pos == str.size() - 1) return substring(str, 1, pos);
+
+    // Decode escape sequences in a single pass (unescaped quotes are only allowed at the end)
+    std::string unsafe;
+    unsafe.reserve(str.size() - 2);
+    unsafe.append(str, 1, pos - 1);
+    for(; pos < str.size() - 1; pos++) {
+        const char c = str[pos];
+        if(c == '"') return std::nullopt;
+        if(c != '\\') {
+            unsafe.push_back(c);
+            continue;
+        }
+
+        switch(str[++pos]) {
+            case '"': unsafe.push_back('"'); break;
+            case 'n': unsafe.push_back('\n'); break;
+            case '\\': unsafe.push_back('\\'); break;
+            default: return std::nullopt;
+        }
+    }
+    if(pos != str.size() - 1) return std::nullopt;
+
+    return unsafe;
 }
 
 template <Enum E> inline std::optional<E> deserializePrimitive(const std::string& str) {
@@ -718,20 +1868,28 @@ template <Enum E> inline std::optional<E> deserializePrimitive(const std::string
     return std::nullopt;
 }
 
-// Pattern: TYPE NAME = VALUE, Returns: (type, name, value)
-inline std::optional<std::array<std::string, 3>> parsePrimitive(const std::string& data) {
-    // Find fixed points
-    const std::size_t space  = data.find(' ');
+inline std::optional<std::string> deserializeLegacyString(const std::string& str) {
+    if(!str.starts_with('"') || !str.ends_with('"')) return std::nullopt;
+    std::string unsafe = substring(str, 1, str.size() - 1);
+    unsafe             = replaceAll(unsafe, "&newline;", "\n");
+    return replaceAll(unsafe, "&quot;", "\"");
+}
+
+// Pattern: TYPE NAME = VALUE (compact: TYPE NAME=VALUE), Returns: (type, name, value)
+inline std::optional<std::array<std::string, 3>> parsePrimitive(const std::string& data) {
+    // Find fixed points
+    const std::size_t space  = data.find(' ');
     const std::size_t equals = data.find('=', space + 1);
 
     // Check fixed points
     if(space == std::string::npos) return std::nullopt;
     if(equals == std::string::npos) return std::nullopt;
 
-    // Extract sections
+    // Extract sections (values never start with a space, so a space after the equals sign marks pretty data)
+    const bool pretty = equals + 1 < data.size() && data.at(equals + 1) == ' ';
     std::string type  = substring(data, 0, space);
-    std::string name  = substring(data, space + 1, equals - 1);
-    std::string value = substring(data, equals + 2, data.size());
+    std::string name  = substring(data, space + 1, pretty ? equals - 1 : equals);
+    std::string value = substring(data, pretty ? equals + 2 : equals + 1, data.size());
 
     // Validate sections
     if(type.empty()) return std::nullopt;
@@ -740,7 +1898,9 @@ inline std::optional<std::array<std::string, 3>> parsePrimitive(const std::strin
     return std::array{ type, name, value };
 }
 
-// Pattern: OBJECT<CLASS> NAME = ADDRESS {\nCHILDREN\n}, Returns: (class, name, address, children)
+// Pattern: OBJECT<CLASS> NAME = ADDRESS {\nCHILDREN\n} (compact: OBJECT<CLASS> NAME=ADDRESS{\nCHILDREN\n}, inline:
+// OBJECT<CLASS> NAME = ADDRESS { CHILDREN }, compact inline: OBJECT<CLASS> NAME=ADDRESS{CHILDREN}),
+// Returns: (class, name, address, children)
 inline std::optional<std::array<std::string, 4>> parseObject(const std::string& data) {
     // Find fixed points
     const std::size_t space   = data.find(' ');
@@ -752,11 +1912,13 @@ inline std::optional<std::array<std::string, 4>> parseObject(const std::string&
     if(equals == std::string::npos) return std::nullopt;
     if(opening == std::string::npos) return std::nullopt;
 
-    // Extract sections
-    std::string classID  = substring(data, 7, space - 1);
-    std::string name     = substring(data, space + 1, equals - 1);
-    std::string address  = substring(data, equals + 2, opening - 1);
-    std::string children = substring(data, opening + 2, data.size() - 2);
+    // Extract sections (inline children are on the line of the object)
+    const bool pretty        = data.at(equals + 1) == ' ';
+    const std::size_t margin = !pretty && data.find('\n', opening) == std::string::npos ? 1 : 2;
+    std::string classID      = substring(data, 7, space - 1);
+    std::string name         = substring(data, space + 1, pretty ? equals - 1 : equals);
+    std::string address      = substring(data, pretty ? equals + 2 : equals + 1, pretty ? opening - 1 : opening);
+    std::string children     = substring(data, opening + margin, data.size() - margin);
 
     // Validate sections
     if(classID.empty()) return std::nullopt;
@@ -765,7 +1927,7 @@ inline std::optional<std::array<std::string, 4>> parseObject(const std::string&
     return std::array{ classID, name, address, children };
 }
 
-// Pattern: PTR<CLASS> NAME = ADDRESS, Returns: (class, name, address)
+// Pattern: PTR<CLASS> NAME = ADDRESS (compact: PTR<CLASS> NAME=ADDRESS), Returns: (class, name, address)
 inline std::optional<std::array<std::string, 3>> parsePointer(const std::string& data) {
     // Find fixed points
     const std::size_t space  = data.find(' ');
@@ -776,9 +1938,10 @@ inline std::optional<std::array<std::string, 3>> parsePointer(const std::string&
     if(equals == std::string::npos) return std::nullopt;
 
     // Extract sections
+    const bool pretty   = equals + 1 < data.size() && data.at(equals + 1) == ' ';
     std::string classID = substring(data, 4, space - 1);
-    std::string name    = substring(data, space + 1, equals - 1);
-    std::string address = substring(data, equals + 2, data.size());
+    std::string name    = substring(data, space + 1, pretty ? equals - 1 : equals);
+    std::string address = substring(data, pretty ? equals + 2 : equals + 1, data.size());
 
     // Validate sections
     if(classID.empty()) return std::nullopt;
@@ -786,273 +1949,3371 @@ inline std::optional<std::array<std::string, 3>> parsePointer(const std::string&
 
     return std::array{ classID, name, address };
 }
-} // namespace string
-} // namespace detail
 
-inline std::pair<Serializable::Result, std::string> Serializable::serialize() {
-    // Setup serialization state
-    mode   = Mode::SERIALIZING;
-    result = Result::OK;
-    serial = std::make_unique<detail::SerialObject>(classID(), "root", std::bit_cast<detail::Address>(this), 0);
+// Pattern: STRINGS {\nENTRIES\n}\nREST (compact: STRINGS{\nENTRIES\n}\nREST), Returns: (entries, rest)
+inline std::optional<std::array<std::string, 2>> parseDictionary(const std::string& data) {
+    // Check prefix
+    const bool pretty = data.starts_with("STRINGS {\n");
+    if(!pretty && !data.starts_with("STRINGS{\n")) return std::nullopt;
 
-    // Run exposers
-    exposed();
-    if(result != Result::OK) return { result, "" };
+    // Find closing bracket (entries are escaped strings, so the first line with a bracket closes the block)
+    const std::size_t closing = data.find("\n}\n");
+    if(closing == std::string::npos) return std::nullopt;
 
-    // Virtualize addresses
-    std::unordered_map<detail::Address, detail::Address> addressMap;
-    serial->asObject()->virtualizeAddresses(addressMap);
-    if(!serial->asObject()->virtualizePointers(addressMap)) return { Result::POINTER, "" };
+    // Extract sections
+    std::string entries = substring(data, pretty ? 10 : 9, closing);
+    std::string rest    = substring(data, closing + 3, data.size());
 
-    return { Result::OK, serial->get() };
+    return std::array{ entries, rest };
 }
 
-inline Serializable::Result Serializable::deserialize(const std::string& data) {
-    // Setup deserialization state
-    mode   = Mode::DESERIALIZING;
-    result = Result::OK;
-    serial = std::make_unique<detail::SerialObject>();
+// Pattern: "NAME" "NAME" ..., Returns: names
+inline std::optional<std::vector<std::string>> parsePath(const std::string& data) {
+    std::vector<std::string> names;
+    std::size_t start = 0;
+    while(start < data.size()) {
+        // Find the closing quote (skipping escaped characters)
+        if(data.at(start) != '"') return std::nullopt;
+        std::size_t end = start + 1;
+        while(end < data.size() && data.at(end) != '"') end += data.at(end) == '\\' ? 2 : 1;
+        if(end >= data.size()) return std::nullopt;
+
+        auto name = deserializePrimitive<std::string>(substring(data, start, end + 1));
+        if(!name) return std::nullopt;
+        names.push_back(std::move(name.value()));
+
+        // Names are separated by a space
+        start = end + 1;
+        if(start < data.size() && data.at(start++) != ' ') return std::nullopt;
+    }
 
-    // Parse serialized data
-    if(!serial->set(data)) return Result::STRUCTURE;
+    if(names.empty()) return std::nullopt;
+    return names;
+}
+} // namespace string
 
-    // Check root object class id
-    if(serial->asObject()->getClass() != classID()) return Result::TYPECHECK;
+namespace packing {
+inline bool isEightDigits(std::uint64_t chunk) {
+    // Every byte is a digit if its high nibble is 3 and adding 6 doesn't carry into the high nibble
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) | ((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4) ==
+           0x3333333333333333;
+}
 
-    // Run exposers
-    exposed();
-    if(result != Result::OK) return result;
+inline std::uint64_t parseEightDigits(std::uint64_t chunk) {
+    // Combine neighbouring digits, then pairs of two and pairs of four digits (the first digit is the lowest byte)
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+    chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+    return (chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
 
-    // Restore addresses
-    serial->asObject()->setRealAddress(std::bit_cast<detail::Address>(this));
-    std::unordered_map<detail::Address, detail::Address> addressMap;
-    serial->asObject()->restoreAddresses(addressMap);
-    if(!serial->asObject()->restorePointers(addressMap)) return Result::POINTER;
+// Pattern: [-] DIGITS (behaves like std::from_chars with base 10)
+template <Integer I> std::from_chars_result parseInteger(std::string_view data, I& value) {
+    static const constexpr std::uint64_t eightDigits = 100000000;
 
-    return Result::OK;
+    // Read sign (only signed types accept a minus)
+    std::size_t pos     = 0;
+    const bool negative = std::is_signed_v<I> && !data.empty() && data[0] == '-';
+    if(negative) pos++;
+
+    // Accumulate eight digits at a time while possible, then single digits (all digits are consumed on overflow)
+    const std::size_t start = pos;
+    std::uint64_t result    = 0;
+    bool overflow           = false;
+    if constexpr(std::endian::native == std::endian::little) {
+        for(; data.size() - pos >= sizeof(std::uint64_t); pos += sizeof(std::uint64_t)) {
+            std::uint64_t chunk = 0;
+            std::memcpy(&chunk, data.substr(pos).data(), sizeof(chunk));
+            if(!isEightDigits(chunk)) break;
+
+            const std::uint64_t digits = parseEightDigits(chunk);
+            overflow                   = overflow || result > (UINT64_MAX - digits) / eightDigits;
+            result                     = result * eightDigits + digits;
+        }
+    }
+    for(; pos < data.size() && data[pos] >= '0' && data[pos] <= '9'; pos++) {
+        const auto digit = static_cast<std::uint64_t>(data[pos] - '0');
+        overflow         = overflow || result > (UINT64_MAX - digit) / 10;
+        result           = result * 10 + digit;
+    }
+    if(pos == start) return { data.data(), std::errc::invalid_argument };
+
+    // Check range and apply sign
+    const auto end   = std::next(data.data(), static_cast<std::ptrdiff_t>(pos));
+    const auto limit = static_cast<std::uint64_t>(std::numeric_limits<I>::max()) + (negative ? 1 : 0);
+    if(overflow || result > limit) return { end, std::errc::result_out_of_range };
+    value = static_cast<I>(negative ? 0 - result : result);
+
+    return { end, std::errc() };
 }
 
-inline Serializable::Result Serializable::save(const std::filesystem::path& path) {
-    // Create parent path
-    if(path.has_parent_path()) std::filesystem::create_directories(path.parent_path());
+// Pattern: [-] (DIGITS [. DIGITS] [(e | E) [+ | -] DIGITS] | nan | inf) (behaves like std::from_chars)
+template <std::floating_point F> std::from_chars_result parseFloat(std::string_view data, F& value) {
+    // Correctly rounded and independent of the locale (libstdc++ and MSVC use an Eisel-Lemire fast path)
+    return std::from_chars(data.data(), std::next(data.data(), static_cast<std::ptrdiff_t>(data.size())), value);
+}
 
-    // Open and check file
-    std::ofstream stream(path);
-    if(!stream) return Result::FILE;
+inline void prefixSum(std::span<Word> words) {
+    // Scan blocks of four words with the log-step pattern of SIMD scans, then add the running total of previous blocks
+    Word carry      = 0;
+    std::size_t pos = 0;
+    for(; pos + 4 <= words.size(); pos += 4) {
+        words[pos + 1] += words[pos];
+        words[pos + 3] += words[pos + 2];
+        words[pos + 2] += words[pos + 1];
+        words[pos + 3] += words[pos + 1];
+        for(std::size_t i = 0; i < 4; i++) words[pos + i] += carry;
+        carry = words[pos + 3];
+    }
 
-    // Serialize data
-    const auto [result, serialized] = serialize();
-    if(result != Result::OK) return result;
+    // Scan remaining words
+    for(; pos < words.size(); pos++) carry = words[pos] += carry;
+}
 
-    // Write serial data
-    stream << serialized;
-    stream.close();
+inline void appendWord(std::string& str, Word word) {
+    // Words are written as signed numbers, so small negative deltas stay short
+    std::array<char, 24> buffer{};
+    const auto [end, _] = std::to_chars(buffer.begin(), buffer.end(), static_cast<std::int64_t>(word));
+    str.append(buffer.begin(), end);
+}
 
-    // Finish
-    return Result::OK;
+inline std::optional<std::vector<Word>> parseWords(const std::string& data) {
+    // Create vector
+    std::vector<Word> words;
+    words.reserve(std::count(data.begin(), data.end(), ' ') + 1);
+
+    // Parse space separated words (eight digits at a time)
+    std::string_view rest = data;
+    while(!rest.empty()) {
+        std::int64_t word        = 0;
+        const auto [next, error] = parseInteger(rest, word);
+        if(error != std::errc()) return std::nullopt;
+        const auto length = static_cast<std::size_t>(next - rest.data());
+        if(length != rest.size() && rest[length] != ' ') return std::nullopt;
+
+        words.push_back(static_cast<Word>(word));
+        rest.remove_prefix(std::min(length + 1, rest.size()));
+    }
+
+    return words;
 }
 
-inline Serializable::Result Serializable::load(const std::filesystem::path& path) {
-    // Open and check file
-    const std::ifstream stream(path);
-    if(!stream) return Result::FILE;
+template <Integer I> std::optional<std::vector<I>> narrow(std::span<const Word> words) {
+    // Create vector
+    std::vector<I> values;
+    values.reserve(words.size());
+
+    // Convert words, rejecting those that don't fit into the target type
+    for(const Word word : words) {
+        const auto value = static_cast<I>(word);
+        if(static_cast<Word>(value) != word) return std::nullopt;
+        values.push_back(value);
+    }
 
-    // Read serialized data
-    std::stringstream str;
-    str << stream.rdbuf();
+    return values;
+}
 
-    // Deserialize data
-    return deserialize(str.str());
+template <Arithmetic T> bool isSame(T a, T b) {
+    // Compare floats bitwise, so -0.0 and NaN are kept as they are
+    if constexpr(std::floating_point<T>) return std::memcmp(&a, &b, sizeof(T)) == 0;
+    else return a == b;
 }
 
-inline unsigned int Serializable::classID() const { return 0; }
+template <Arithmetic T> void appendValue(std::string& str, T value) {
+    // Floats are written in their shortest form reading back to the same value
+    std::array<char, 32> buffer{};
+    const auto [end, _] = std::to_chars(buffer.begin(), buffer.end(), value);
+    str.append(buffer.begin(), end);
+}
 
-template <detail::SerializablePrimitive P> void Serializable::expose(const std::string& name, P& value) {
-    // Abort if a previous error was detected
-    if(result != Result::OK) return;
+template <Arithmetic T> bool parseValue(std::string_view& data, T& value) {
+    // Parse value and consume the following space (if any)
+    std::from_chars_result parsed;
+    if constexpr(std::floating_point<T>) parsed = parseFloat(data, value);
+    else parsed = parseInteger(data, value);
+    if(parsed.ec != std::errc()) return false;
+    const auto length = static_cast<std::size_t>(parsed.ptr - data.data());
+    if(length != data.size() && data[length] != ' ') return false;
 
-    if(mode == Mode::SERIALIZING) {
-        // Append new serial primitive to root
-        serial->asObject()->append(std::make_unique<detail::SerialPrimitive>(
-          detail::string::TypeToString<P>, name, detail::string::serializePrimitive(value)));
-    } else {
-        // Find serial value in root object
-        const auto serialValue = serial->asObject()->getChild(name);
-        if(!serialValue) {
-            result = Result::INTEGRITY;
-            return;
-        }
+    data.remove_prefix(std::min(length + 1, data.size()));
+    return true;
+}
 
-        // Convert to serial primitive
-        const auto* serialPrimitive = serialValue.value()->asPrimitive();
-        if(serialPrimitive == nullptr) {
-            result = Result::TYPECHECK;
-            return;
-        }
+// Pattern: COUNT FIRST DELTA...
+template <std::ranges::input_range R> std::string encodeDelta(const R& values) {
+    std::string str = std::to_string(std::ranges::distance(values));
+
+    // Append differences to the previous value (modulo 2^64, so unsigned values wrap correctly)
+    Word previous = 0;
+    for(const auto& value : values) {
+        const auto word = static_cast<Word>(value);
+        str.push_back(' ');
+        appendWord(str, word - previous);
+        previous = word;
+    }
 
-        // Check primitive type
-        if(serialPrimitive->getType() != detail::string::TypeToString<P>) {
-            result = Result::TYPECHECK;
-            return;
+    return str;
+}
+
+// Pattern: COUNT FIRST DELTA DELTA_OF_DELTA...
+template <std::ranges::input_range R> std::string encodeDeltaOfDelta(const R& values) {
+    std::string str = std::to_string(std::ranges::distance(values));
+
+    // Append first value and delta as is, then the differences between consecutive deltas
+    Word previous = 0, previousDelta = 0;
+    std::size_t index = 0;
+    for(const auto& value : values) {
+        const auto word  = static_cast<Word>(value);
+        const Word delta = word - previous;
+        str.push_back(' ');
+        appendWord(str, index++ < 2 ? delta : delta - previousDelta);
+        previous      = word;
+        previousDelta = delta;
+    }
+
+    return str;
+}
+
+// Pattern: COUNT MINIMUM WIDTH BITS
+template <std::ranges::input_range R> std::string encodeFrameOfReference(const R& values) {
+    using I = std::ranges::range_value_t<R>;
+
+    // Find frame of reference
+    const std::size_t count = std::ranges::distance(values);
+    I minimum{}, maximum{};
+    if(count > 0) {
+        const auto [min, max] = std::ranges::minmax_element(values);
+        minimum               = *min;
+        maximum               = *max;
+    }
+    const std::size_t width = std::bit_width(static_cast<Word>(maximum) - static_cast<Word>(minimum));
+
+    // Pack offsets to the minimum into width bits each (least significant bit first)
+    std::vector<unsigned char> bytes((count * width + 7) / 8);
+    std::size_t bit = 0;
+    for(const auto& value : values) {
+        const Word offset = static_cast<Word>(value) - static_cast<Word>(minimum);
+        for(std::size_t done = 0; done < width;) {
+            const std::size_t shift = bit % 8;
+            const std::size_t take  = std::min(width - done, 8 - shift);
+            bytes[bit / 8] |= static_cast<unsigned char>(((offset >> done) & ((1U << take) - 1)) << shift);
+            done += take;
+            bit += take;
         }
+    }
 
-        // Get primitive value
-        const auto primitiveValue = detail::string::deserializePrimitive<P>(serialPrimitive->getValue());
-        if(!primitiveValue) {
-            result = Result::TYPECHECK;
-            return;
+    return string::makeString(std::to_string(count), " ", std::to_string(minimum), " ", std::to_string(width), " ",
+                              string::encodeBase64(bytes));
+}
+
+template <Integer I> std::optional<std::vector<I>> decodeDelta(const std::string& data) {
+    // Parse words and check count
+    auto words = parseWords(data);
+    if(!words || words->empty()) return std::nullopt;
+    if(words->front() != words->size() - 1) return std::nullopt;
+
+    // Sum up deltas
+    const std::span<Word> deltas(std::next(words->begin()), words->end());
+    prefixSum(deltas);
+
+    return narrow<I>(deltas);
+}
+
+template <Integer I> std::optional<std::vector<I>> decodeDeltaOfDelta(const std::string& data) {
+    // Parse words and check count
+    auto words = parseWords(data);
+    if(!words || words->empty()) return std::nullopt;
+    if(words->front() != words->size() - 1) return std::nullopt;
+
+    // Sum up deltas of deltas (everything after the first value) to deltas, then deltas to values
+    const std::span<Word> deltas(std::next(words->begin()), words->end());
+    if(deltas.size() > 1) prefixSum(deltas.subspan(1));
+    prefixSum(deltas);
+
+    return narrow<I>(deltas);
+}
+
+template <Integer I> std::optional<std::vector<I>> decodeFrameOfReference(const std::string& data) {
+    // Split and check sections
+    const auto sections = string::split(data, ' ');
+    if(sections.size() != 4) return std::nullopt;
+
+    // Parse header
+    std::size_t count = 0, width = 0;
+    I minimum{};
+    const auto parse = [](const std::string& str, auto& target) {
+        const auto [end, error] = parseInteger(str, target);
+        return error == std::errc() && end == str.data() + str.size(); // NOLINT(*-pointer-arithmetic)
+    };
+    if(!parse(sections[0], count) || !parse(sections[1], minimum) || !parse(sections[2], width)) return std::nullopt;
+    if(width > sizeof(Word) * CHAR_BIT) return std::nullopt;
+    if(width == 0 ? count > MAX_ELEMENTS : count > (std::numeric_limits<std::size_t>::max() - 7) / width)
+        return std::nullopt;
+
+    // Decode and check bits
+    const auto bytes = string::decodeBase64(sections[3]);
+    if(!bytes || bytes->size() != (count * width + 7) / 8) return std::nullopt;
+
+    // Unpack offsets and add the minimum
+    std::vector<Word> words(count, static_cast<Word>(minimum));
+    std::size_t bit = 0;
+    for(auto& word : words) {
+        Word offset = 0;
+        for(std::size_t done = 0; done < width;) {
+            const std::size_t shift = bit % 8;
+            const std::size_t take  = std::min(width - done, 8 - shift);
+            offset |= static_cast<Word>((bytes->at(bit / 8) >> shift) & ((1U << take) - 1)) << done;
+            done += take;
+            bit += take;
         }
+        word += offset;
+    }
 
-        // Set value
-        value = primitiveValue.value();
+    return narrow<I>(words);
+}
+
+// Pattern: COUNT VALUE LENGTH...
+template <std::ranges::input_range R> std::string encodeRunLength(const R& values) {
+    std::string str = std::to_string(std::ranges::distance(values));
+
+    // Append every run of equal values as value and length
+    auto it = std::ranges::begin(values);
+    while(it != std::ranges::end(values)) {
+        const auto value   = *it;
+        std::size_t length = 0;
+        for(; it != std::ranges::end(values) && isSame(*it, value); it++) length++;
+
+        str.push_back(' ');
+        appendValue(str, value);
+        str.push_back(' ');
+        appendValue(str, length);
     }
+
+    return str;
 }
 
-inline void Serializable::expose(const std::string& name, Serializable& value) {
-    // Abort if previous error was detected
-    if(result != Result::OK) return;
+// Pattern: COUNT FILL GAP VALUE...
+template <std::ranges::input_range R> std::string encodeSparse(const R& values) {
+    using T = std::ranges::range_value_t<R>;
 
-    if(mode == Mode::SERIALIZING) {
-        // Serialize object
-        value.mode   = Mode::SERIALIZING;
-        value.result = Result::OK;
-        value.serial =
-          std::make_unique<detail::SerialObject>(value.classID(), name, std::bit_cast<detail::Address>(&value), 0);
-        value.exposed();
+    // Find the majority value (Boyer-Moore vote) to fill the container with
+    T fill{};
+    std::size_t votes = 0;
+    for(const auto& value : values) {
+        if(votes == 0) fill = value;
+        votes = isSame(value, fill) ? votes + 1 : votes - 1;
+    }
 
-        // Take result
-        if(value.result != result) {
-            result = value.result;
-            return;
+    // Append every other value with the distance to the previous one
+    std::string str = std::to_string(std::ranges::distance(values));
+    str.push_back(' ');
+    appendValue(str, fill);
+    std::size_t index = 0, previous = 0;
+    for(const auto& value : values) {
+        if(!isSame(value, fill)) {
+            str.push_back(' ');
+            appendValue(str, index - previous);
+            str.push_back(' ');
+            appendValue(str, value);
+            previous = index;
         }
+        index++;
+    }
 
-        // Append serial object to root
-        serial->asObject()->append(std::move(value.serial));
-    } else {
-        // Find serial value in root object
-        const auto serialValue = serial->asObject()->getChild(name);
-        if(!serialValue) {
-            result = Result::INTEGRITY;
-            return;
-        }
+    return str;
+}
 
-        // Convert to serial object
-        auto* serialObject = serialValue.value()->asObject();
-        if(serialObject == nullptr) {
-            result = Result::TYPECHECK;
-            return;
-        }
+template <Arithmetic T>
+std::optional<std::vector<T>> decodeRunLength(const std::string& data, std::size_t maximum) {
+    // Parse count (runs can not decode to more elements than their data allows, nothing is reserved up front)
+    std::string_view rest = data;
+    std::size_t count     = 0;
+    if(!parseValue(rest, count)) return std::nullopt;
+    if(count > std::min({ maximum, MAX_ELEMENTS, data.size() * MAX_RUN_EXPANSION })) return std::nullopt;
+
+    // Fill runs (which must add up to the count)
+    std::vector<T> values;
+    while(!rest.empty()) {
+        T value{};
+        std::size_t length = 0;
+        if(!parseValue(rest, value) || !parseValue(rest, length)) return std::nullopt;
+        if(length == 0 || length > count - values.size()) return std::nullopt;
+        values.insert(values.end(), length, value);
+    }
+    if(values.size() != count) return std::nullopt;
 
-        // Check class id
-        if(serialObject->getClass() != value.classID()) {
-            result = Result::TYPECHECK;
-            return;
+    return values;
+}
+
+template <Arithmetic T> std::optional<std::vector<T>> decodeSparse(const std::string& data, std::size_t maximum) {
+    // Parse count (at most the size of fixed size containers) and fill
+    std::string_view rest = data;
+    std::size_t count     = 0;
+    T fill{};
+    if(!parseValue(rest, count) || !parseValue(rest, fill)) return std::nullopt;
+    if(count > std::min(maximum, MAX_ELEMENTS)) return std::nullopt;
+
+    // Fill container, then scatter the other values
+    std::vector<T> values(count, fill);
+    std::size_t index = 0;
+    bool first        = true;
+    while(!rest.empty()) {
+        std::size_t gap = 0;
+        T value{};
+        if(!parseValue(rest, gap) || !parseValue(rest, value)) return std::nullopt;
+        if(gap >= count - index || (!first && gap == 0)) return std::nullopt;
+        index += gap;
+        values[index] = value;
+        first         = false;
+    }
+
+    return values;
+}
+
+template <std::floating_point F>
+void quantize(std::span<const F> values, double scale, unsigned int bits, std::span<std::int32_t> codes) {
+    // Limits of signed numbers of the bit width (NaN is clamped to the lower one)
+    const std::int64_t low  = -(std::int64_t{ 1 } << (bits - 1));
+    const std::int64_t high = (std::int64_t{ 1 } << (bits - 1)) - 1;
+    const auto inverse      = static_cast<F>(1 / scale);
+    const auto lowF = static_cast<F>(low), highF = static_cast<F>(high);
+    std::size_t pos = 0;
+
+#if defined(__SSE2__)
+    // Scale, clamp and round four floats at a time (limits above 24 bits can not be represented exactly)
+    if constexpr(std::is_same_v<F, float>) {
+        if(bits <= 24) {
+            const __m128 factor = _mm_set1_ps(inverse);
+            const __m128 lower  = _mm_set1_ps(lowF);
+            const __m128 upper  = _mm_set1_ps(highF);
+            for(; pos + 4 <= values.size(); pos += 4) {
+                const __m128 scaled = _mm_mul_ps(_mm_loadu_ps(values.subspan(pos).data()), factor);
+                const __m128i code  = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(scaled, lower), upper));
+                _mm_storeu_si128(std::bit_cast<__m128i*>(codes.subspan(pos).data()), code);
+            }
         }
+    }
+#endif
 
-        // Set objects real address
-        serialObject->setRealAddress(std::bit_cast<detail::Address>(&value));
+    // Scale, clamp and round remaining numbers the same way (to nearest, ties to even)
+    for(; pos < values.size(); pos++) {
+        const F scaled  = values[pos] * inverse;
+        const F bounded = scaled > lowF ? (scaled < highF ? scaled : highF) : lowF;
+        codes[pos]      = static_cast<std::int32_t>(std::clamp<std::int64_t>(std::llrint(bounded), low, high));
+    }
+}
 
-        // Deserialize object
-        value.mode   = Mode::DESERIALIZING;
-        value.result = Result::OK;
-        value.serial = serialObject->clone();
-        value.exposed();
+template <std::floating_point F>
+void dequantize(std::span<const std::int32_t> codes, double scale, std::span<F> values) {
+    const auto factor = static_cast<F>(scale);
+    std::size_t pos   = 0;
 
-        // Take result
-        if(value.result != result) {
-            result = value.result;
-            return;
+#if defined(__SSE2__)
+    // Convert and scale four floats at a time
+    if constexpr(std::is_same_v<F, float>) {
+        const __m128 multiplier = _mm_set1_ps(factor);
+        for(; pos + 4 <= codes.size(); pos += 4) {
+            const __m128i code = _mm_loadu_si128(std::bit_cast<const __m128i*>(codes.subspan(pos).data()));
+            _mm_storeu_ps(values.subspan(pos).data(), _mm_mul_ps(_mm_cvtepi32_ps(code), multiplier));
         }
     }
+#endif
+
+    // Convert and scale remaining numbers
+    for(; pos < codes.size(); pos++) values[pos] = static_cast<F>(codes[pos]) * factor;
 }
 
-template <detail::SerializableObject O> void Serializable::expose(const std::string& name, O*& value) {
-    // Abort if previous error was detected
-    if(result != Result::OK) return;
+inline std::uint16_t toHalf(float value) {
+    const auto bits              = std::bit_cast<std::uint32_t>(value);
+    const auto sign              = static_cast<std::uint16_t>(bits >> 16 & 0x8000);
+    const std::uint32_t exponent = bits >> 23 & 0xFF;
+    std::uint32_t mantissa       = bits & 0x7FFFFF;
+
+    // Infinity and NaN (keeping NaNs quiet), overflow to infinity
+    if(exponent == 0xFF) return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+    const int biased = static_cast<int>(exponent) - 127 + 15;
+    if(biased >= 31) return sign | 0x7C00;
+
+    // Round mantissa to nearest, ties to even (subnormal halves keep fewer bits, a carry increments the exponent)
+    std::uint32_t shift = 13, half = 0;
+    if(biased <= 0) {
+        if(biased < -10) return sign;
+        mantissa |= 0x800000;
+        shift = static_cast<std::uint32_t>(14 - biased);
+    } else half = static_cast<std::uint32_t>(biased) << 10;
+    half |= mantissa >> shift;
+    const std::uint32_t rest = mantissa & ((1U << shift) - 1), halfway = 1U << (shift - 1);
+    if(rest > halfway || (rest == halfway && (half & 1) != 0)) half++;
+
+    return static_cast<std::uint16_t>(sign | half);
+}
 
-    // Abort if value is a nullptr
-    if(value == nullptr) {
-        result = Result::POINTER;
-        return;
+inline float fromHalf(std::uint16_t half) {
+    const std::uint32_t sign     = static_cast<std::uint32_t>(half & 0x8000) << 16;
+    const std::uint32_t exponent = half >> 10 & 0x1F;
+    const std::uint32_t mantissa = half & 0x3FF;
+
+    // Infinity and NaN, zero and subnormals, normal numbers
+    if(exponent == 0x1F) return std::bit_cast<float>(sign | 0x7F800000 | mantissa << 13);
+    if(exponent == 0) {
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -magnitude : magnitude;
     }
+    return std::bit_cast<float>(sign | (exponent + 112) << 23 | mantissa << 13);
+}
 
-    // Get address from value
-    void** address = std::bit_cast<void**>(&value);
+template <std::floating_point F> void toHalf(std::span<const F> values, std::span<std::uint16_t> halves) {
+    std::size_t pos = 0;
 
-    if(mode == Mode::SERIALIZING) {
-        // Append new serial pointer to root
-        serial->asObject()->append(std::make_unique<detail::SerialPointer>(value->classID(), name, address));
-    } else {
-        // Find serial value in root object
-        const auto serialValue = serial->asObject()->getChild(name);
-        if(!serialValue) {
-            result = Result::INTEGRITY;
-            return;
+#if defined(__F16C__)
+    // Convert four floats at a time
+    if constexpr(std::is_same_v<F, float>) {
+        for(; pos + 4 <= values.size(); pos += 4) {
+            const __m128i half = _mm_cvtps_ph(_mm_loadu_ps(values.subspan(pos).data()), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storel_epi64(std::bit_cast<__m128i*>(halves.subspan(pos).data()), half);
         }
+    }
+#endif
 
-        // Convert to serial pointer
-        auto* serialPointer = serialValue.value()->asPointer();
-        if(serialPointer == nullptr) {
-            result = Result::TYPECHECK;
-            return;
-        }
+    for(; pos < values.size(); pos++) halves[pos] = toHalf(static_cast<float>(values[pos]));
+}
 
-        // Check pointer type
-        if(serialPointer->getClass() != value->classID()) {
-            result = Result::TYPECHECK;
-            return;
-        }
+template <std::floating_point F> void fromHalf(std::span<const std::uint16_t> halves, std::span<F> values) {
+    std::size_t pos = 0;
 
-        // Register location for address mapping
-        serialPointer->setTarget(address);
+#if defined(__F16C__)
+    // Convert four halves at a time
+    if constexpr(std::is_same_v<F, float>) {
+        for(; pos + 4 <= halves.size(); pos += 4) {
+            const __m128i half = _mm_loadl_epi64(std::bit_cast<const __m128i*>(halves.subspan(pos).data()));
+            _mm_storeu_ps(values.subspan(pos).data(), _mm_cvtph_ps(half));
+        }
     }
-}
+#endif
 
-template <detail::SerializableContainer C> void Serializable::expose(const std::string& name, C& value) {
-    // Abort if previous error was detected
-    if(result != Result::OK) return;
+    for(; pos < halves.size(); pos++) values[pos] = static_cast<F>(fromHalf(halves[pos]));
+}
 
-    // Create new serial container
-    detail::SerialContainer<C> serialContainer(value);
+// Pattern: SCALE COUNT MINIMUM WIDTH BITS (fixed point numbers packed as frame of reference)
+template <std::floating_point F> std::string encodeFixed(std::span<const F> values, double scale, unsigned int bits) {
+    std::vector<std::int32_t> codes(values.size());
+    quantize(values, scale, bits, std::span(codes));
 
-    // Expose container
-    expose(name, serialContainer);
+    std::string str;
+    appendValue(str, scale);
+    str.push_back(' ');
+    str.append(encodeFrameOfReference(codes));
+    return str;
 }
 
-namespace detail {
-template <SerializableContainer C> SerialContainer<C>::SerialContainer(C& value) : value(&value) {}
+// Pattern: COUNT BITS (16 bits per number, little endian)
+template <std::floating_point F> std::string encodeHalf(std::span<const F> values) {
+    std::vector<std::uint16_t> halves(values.size());
+    toHalf(values, std::span(halves));
 
-template <SerializableContainer C> void SerialContainer<C>::exposed() {
-    if constexpr(requires { value->begin()->first; }) {
-        // Generate list of keys
-        std::list<std::string> keys;
-        for(auto& [key, _] : *value) keys.push_back(key);
+    std::vector<unsigned char> bytes;
+    bytes.reserve(halves.size() * 2);
+    for(const std::uint16_t half : halves) {
+        bytes.push_back(static_cast<unsigned char>(half & 0xFF));
+        bytes.push_back(static_cast<unsigned char>(half >> 8));
+    }
+    return string::makeString(std::to_string(halves.size()), " ", string::encodeBase64(bytes));
+}
 
-        // Expose keys
-        expose("keys", keys);
+template <std::floating_point F> std::optional<std::vector<F>> decodeFixed(const std::string& data) {
+    // Parse scale and fixed point numbers
+    std::string_view rest = data;
+    double scale          = 0;
+    if(!parseValue(rest, scale) || !std::isfinite(scale) || scale <= 0) return std::nullopt;
+    const auto codes = decodeFrameOfReference<std::int32_t>(std::string(rest));
+    if(!codes) return std::nullopt;
+
+    // Scale fixed point numbers
+    std::vector<F> values(codes->size());
+    dequantize(std::span<const std::int32_t>(codes.value()), scale, std::span(values));
+    return values;
+}
 
-        // Expose elements
-        for(const auto& key : keys) expose(key, (*value)[key]);
+template <std::floating_point F> std::optional<std::vector<F>> decodeHalf(const std::string& data) {
+    // Split sections and check size
+    const auto sections = string::split(data, ' ');
+    if(sections.size() != 2) return std::nullopt;
+    std::size_t count = 0;
+    std::string_view size = sections[0];
+    if(!parseValue(size, count) || !size.empty()) return std::nullopt;
+    const auto bytes = string::decodeBase64(sections[1]);
+    if(!bytes || bytes->size() != count * 2) return std::nullopt;
+
+    // Convert halves
+    std::vector<std::uint16_t> halves(count);
+    for(std::size_t i = 0; i < count; i++)
+        halves[i] = static_cast<std::uint16_t>(bytes->at(2 * i) | bytes->at(2 * i + 1) << 8);
+    std::vector<F> values(count);
+    fromHalf(std::span<const std::uint16_t>(halves), std::span(values));
+    return values;
+}
+} // namespace packing
 
-        // Remove keys that are not in the container anymore
-        for(auto it = value->begin(); it != value->end();)
-            if(std::find(keys.begin(), keys.end(), it->first) == keys.end()) it = value->erase(it);
-            else it++;
-    } else {
-        // If container supports resize, expose size and resize container
-        if constexpr(requires { value->resize(0); }) {
-            // Expose size
-            std::size_t size = value->size();
-            expose("size", size);
+namespace checksum {
+inline std::uint32_t crc32c(std::string_view data, std::uint32_t crc) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    // Use the SSE4.2 crc32 instruction if the CPU supports it
+    static const bool hardware = __builtin_cpu_supports("sse4.2") != 0;
+    if(hardware) return crc32cHardware(data, crc);
+#endif
+
+    return crc32cSoftware(data, crc);
+}
 
-            // Resize container
-            if(size != value->size()) value->resize(size);
+inline std::uint32_t crc32cSoftware(std::string_view data, std::uint32_t crc) {
+    // Generate lookup table for the reflected Castagnoli polynomial
+    static const constexpr auto table = [] {
+        std::array<std::uint32_t, 256> table{};
+        for(std::uint32_t i = 0; i < table.size(); i++) {
+            std::uint32_t value = i;
+            for(int bit = 0; bit < 8; bit++) value = (value >> 1) ^ ((value & 1) != 0 ? 0x82F63B78U : 0);
+            table[i] = value;
         }
+        return table;
+    }();
 
-        // Expose elements
-        std::size_t index = 0;
-        for(auto& element : *value) expose(string::serializePrimitive(index++), element);
+    // Process data byte by byte
+    crc = ~crc;
+    for(const char c : data) crc = table[(crc ^ static_cast<unsigned char>(c)) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+__attribute__((target("sse4.2"))) inline std::uint32_t crc32cHardware(std::string_view data, std::uint32_t crc) {
+    std::uint64_t value = ~crc;
+    std::size_t pos     = 0;
+
+    // Process eight bytes at a time
+    for(; pos + sizeof(std::uint64_t) <= data.size(); pos += sizeof(std::uint64_t)) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, &data[pos], sizeof(word));
+        value = _mm_crc32_u64(value, word);
     }
+
+    // Process remaining bytes
+    auto result = static_cast<std::uint32_t>(value);
+    for(; pos < data.size(); pos++) result = _mm_crc32_u8(result, static_cast<unsigned char>(data[pos]));
+    return ~result;
+}
+#else
+inline std::uint32_t crc32cHardware(std::string_view data, std::uint32_t crc) { return crc32cSoftware(data, crc); }
+#endif
+
+inline std::uint32_t xxhash32(std::string_view data, std::uint32_t seed) {
+    static const constexpr std::uint32_t PRIME1 = 0x9E3779B1U, PRIME2 = 0x85EBCA77U, PRIME3 = 0xC2B2AE3DU,
+                                         PRIME4 = 0x27D4EB2FU, PRIME5 = 0x165667B1U;
+
+    // Helpers for reading words and mixing stripes
+    const auto read = [&data](std::size_t pos) {
+        std::uint32_t value = 0;
+        std::memcpy(&value, &data[pos], sizeof(value));
+        return value;
+    };
+
+    const auto round = [](std::uint32_t accumulator, std::uint32_t input) {
+        return std::rotl(accumulator + input * PRIME2, 13) * PRIME1;
+    };
+
+    // Process stripes of sixteen bytes in four independent lanes
+    std::size_t pos    = 0;
+    std::uint32_t hash = seed + PRIME5;
+    if(data.size() >= 16) {
+        std::array<std::uint32_t, 4> lanes = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+        for(; pos + 16 <= data.size(); pos += 16)
+            for(std::size_t i = 0; i < lanes.size(); i++) lanes[i] = round(lanes[i], read(pos + 4 * i));
+        hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+    }
+    hash += static_cast<std::uint32_t>(data.size());
+
+    // Process remaining words and bytes
+    for(; pos + 4 <= data.size(); pos += 4) hash = std::rotl(hash + read(pos) * PRIME3, 17) * PRIME4;
+    for(; pos < data.size(); pos++)
+        hash = std::rotl(hash + static_cast<unsigned char>(data[pos]) * PRIME5, 11) * PRIME1;
+
+    // Avalanche
+    hash ^= hash >> 15;
+    hash *= PRIME2;
+    hash ^= hash >> 13;
+    hash *= PRIME3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+inline std::uint64_t xxhash64(std::string_view data, std::uint64_t seed) {
+    static const constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87U, PRIME2 = 0xC2B2AE3D27D4EB4FU,
+                                         PRIME3 = 0x165667B19E3779F9U, PRIME4 = 0x85EBCA77C2B2AE63U,
+                                         PRIME5 = 0x27D4EB2F165667C5U;
+
+    // Helpers for reading words and mixing stripes
+    const auto read = [&data]<typename T>(std::size_t pos, T value) {
+        std::memcpy(&value, &data[pos], sizeof(value));
+        return value;
+    };
+
+    const auto round = [](std::uint64_t accumulator, std::uint64_t input) {
+        return std::rotl(accumulator + input * PRIME2, 31) * PRIME1;
+    };
+
+    // Process stripes of 32 bytes in four independent lanes, then merge the lanes
+    std::size_t pos    = 0;
+    std::uint64_t hash = seed + PRIME5;
+    if(data.size() >= 32) {
+        std::array<std::uint64_t, 4> lanes = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+        for(; pos + 32 <= data.size(); pos += 32)
+            for(std::size_t i = 0; i < lanes.size(); i++)
+                lanes[i] = round(lanes[i], read(pos + 8 * i, std::uint64_t{}));
+        hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+        for(const std::uint64_t lane : lanes) hash = (hash ^ round(0, lane)) * PRIME1 + PRIME4;
+    }
+    hash += data.size();
+
+    // Process remaining words and bytes
+    for(; pos + 8 <= data.size(); pos += 8)
+        hash = std::rotl(hash ^ round(0, read(pos, std::uint64_t{})), 27) * PRIME1 + PRIME4;
+    if(pos + 4 <= data.size()) {
+        hash = std::rotl(hash ^ read(pos, std::uint32_t{}) * PRIME1, 23) * PRIME2 + PRIME3;
+        pos += 4;
+    }
+    for(; pos < data.size(); pos++)
+        hash = std::rotl(hash ^ static_cast<unsigned char>(data[pos]) * PRIME5, 11) * PRIME1;
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+} // namespace checksum
+
+namespace json {
+inline void writeString(std::string& data, std::string_view str) {
+    static const constexpr auto hex = "0123456789abcdef";
+
+    data.push_back('"');
+    for(std::size_t pos = 0; pos < str.size();) {
+        // Copy characters that don't have to be escaped at once
+        const std::size_t end = scanString(str, pos);
+        data.append(str.substr(pos, end - pos));
+        if(end == str.size()) break;
+
+        // Escape quote, backslash or control character
+        const auto c = static_cast<unsigned char>(str[end]);
+        switch(c) {
+            case '"': data.append("\\\""); break;
+            case '\\': data.append("\\\\"); break;
+            case '\n': data.append("\\n"); break;
+            case '\r': data.append("\\r"); break;
+            case '\t': data.append("\\t"); break;
+            default:
+                data.append("\\u00");
+                data.push_back(hex[c >> 4]);   // NOLINT(*-pointer-arithmetic)
+                data.push_back(hex[c & 0xF]);  // NOLINT(*-pointer-arithmetic)
+        }
+        pos = end + 1;
+    }
+    data.push_back('"');
+}
+
+// Pattern: [-] (0 | DIGITS) [. DIGITS] [(e | E) [+ | -] DIGITS]
+inline bool isNumber(std::string_view str) {
+    std::size_t pos   = 0;
+    const auto digits = [&] {
+        const std::size_t start = pos;
+        while(pos < str.size() && str[pos] >= '0' && str[pos] <= '9') pos++;
+        return pos > start;
+    };
+    const auto next = [&](char c) {
+        if(pos >= str.size() || str[pos] != c) return false;
+        pos++;
+        return true;
+    };
+
+    next('-');
+    if(!next('0') && !digits()) return false;
+    if(next('.') && !digits()) return false;
+    if(next('e') || next('E')) {
+        if(!next('+')) next('-');
+        if(!digits()) return false;
+    }
+    return pos == str.size();
+}
+
+inline std::size_t scanString(std::string_view data, std::size_t pos) {
+#if defined(__SSE2__)
+    // Compare 16 characters at a time against quotes, backslashes and control characters
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control   = _mm_set1_epi8(0x1F);
+    for(; pos + sizeof(__m128i) <= data.size(); pos += sizeof(__m128i)) {
+        const __m128i chunk = _mm_loadu_si128(std::bit_cast<const __m128i*>(data.data() + pos));
+        const __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                           _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+        const auto mask     = static_cast<unsigned int>(_mm_movemask_epi8(found));
+        if(mask != 0) return pos + std::countr_zero(mask);
+    }
+#endif
+
+    // Compare remaining characters one by one
+    for(; pos < data.size(); pos++) {
+        const auto c = static_cast<unsigned char>(data[pos]);
+        if(c == '"' || c == '\\' || c < 0x20) return pos;
+    }
+    return data.size();
+}
+
+template <SerializablePrimitive P>
+std::optional<std::string> typedValue(const std::string& type, const std::string& value) {
+    // Values with matching type
+    if(type == string::TypeToString<P>) return value;
+
+    // Numbers read from JSON (integers can't have a fraction or an exponent, floats might be nan or inf strings)
+    if constexpr(std::is_floating_point_v<P>) {
+        if(type == NUMBER) return value;
+        if(type == string::TypeToString<std::string> &&
+           (value == "\"nan\"" || value == "\"-nan\"" || value == "\"inf\"" || value == "\"-inf\""))
+            return value.substr(1, value.size() - 2);
+    } else if constexpr(Integer<P> || Enum<P>) {
+        if(type == NUMBER && value.find_first_of(".eE") == std::string::npos) return value;
+    }
+
+    return std::nullopt;
+}
+
+inline std::unique_ptr<Serial> finishObject(std::unique_ptr<SerialObject> object, std::string name,
+                                            unsigned int classID, Address address, bool reference,
+                                            const std::vector<std::string>& keys) {
+    // Create pointer
+    if(reference) {
+        if(!keys.empty()) return nullptr;
+        return std::make_unique<SerialPointer>(classID, std::move(name), address);
+    }
+
+    // Add list of keys to objects without class id (maps expect them)
+    object->emplace(classID, std::move(name), 0, address);
+    if(classID == 0 && !object->getChild("keys")) {
+        auto list = std::make_unique<SerialObject>(0, "keys", 0, 0);
+        list->append(std::make_unique<SerialPrimitive>(string::TypeToString<std::size_t>, "size",
+                                                       string::serializePrimitive(keys.size())));
+        for(std::size_t index = 0; index < keys.size(); index++)
+            list->append(std::make_unique<SerialPrimitive>(string::TypeToString<std::string>,
+                                                           string::serializePrimitive(index),
+                                                           string::serializePrimitive(keys[index])));
+        object->append(std::move(list));
+    }
+
+    return object;
+}
+
+inline Parser::Parser(std::string_view data) : data(data) {}
+
+inline std::unique_ptr<SerialObject> Parser::parse() {
+    // Parse root object (the only value allowed at the top level)
+    skipWhitespace();
+    if(pos >= data.size() || data[pos] != '{') return nullptr;
+    auto root = parseObject("root");
+    skipWhitespace();
+    if(!root || root->asObject() == nullptr || pos != data.size()) return nullptr;
+
+    return std::unique_ptr<SerialObject>(root.release()->asObject());
+}
+
+inline void Parser::skipWhitespace() {
+    while(pos < data.size() && (data[pos] == ' ' || data[pos] == '\n' || data[pos] == '\r' || data[pos] == '\t')) pos++;
+}
+
+inline bool Parser::consume(char c) {
+    skipWhitespace();
+    if(pos >= data.size() || data[pos] != c) return false;
+    pos++;
+    return true;
+}
+
+inline std::optional<std::string_view> Parser::parseString() {
+    if(!consume('"')) return std::nullopt;
+
+    // Use strings without escape sequences directly
+    std::size_t end = scanString(data, pos);
+    if(end < data.size() && data[end] == '"') {
+        const std::string_view str = data.substr(pos, end - pos);
+        pos                        = end + 1;
+        return str;
+    }
+
+    // Decode escape sequences into the buffer
+    const auto hex = [&]() -> std::optional<unsigned int> {
+        const std::string_view digits = data.substr(pos, 4);
+        const char* last              = digits.data() + digits.size(); // NOLINT(*-pointer-arithmetic)
+        unsigned int value            = 0;
+        const auto [end, error]       = std::from_chars(digits.data(), last, value, 16);
+        if(digits.size() != 4 || error != std::errc() || end != last) return std::nullopt;
+        pos += 4;
+        return value;
+    };
+    buffer.assign(data.substr(pos, end - pos));
+    pos = end;
+    while(pos < data.size()) {
+        // Finish at the closing quote, fail at control characters
+        const char c = data[pos++];
+        if(c == '"') return buffer;
+        if(c != '\\' || pos >= data.size()) return std::nullopt;
+
+        switch(const char escaped = data[pos++]) {
+            case '"':
+            case '\\':
+            case '/': buffer.push_back(escaped); break;
+            case 'b': buffer.push_back('\b'); break;
+            case 'f': buffer.push_back('\f'); break;
+            case 'n': buffer.push_back('\n'); break;
+            case 'r': buffer.push_back('\r'); break;
+            case 't': buffer.push_back('\t'); break;
+            case 'u': {
+                // Combine surrogate pairs and encode code point as UTF-8
+                auto codePoint = hex();
+                if(!codePoint || (codePoint >= 0xDC00 && codePoint <= 0xDFFF)) return std::nullopt;
+                if(codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    if(data.substr(pos, 2) != "\\u") return std::nullopt;
+                    pos += 2;
+                    const auto low = hex();
+                    if(!low || low < 0xDC00 || low > 0xDFFF) return std::nullopt;
+                    codePoint = 0x10000 + ((codePoint.value() - 0xD800) << 10) + (low.value() - 0xDC00);
+                }
+
+                const unsigned int value = codePoint.value();
+                if(value < 0x80) buffer.push_back(static_cast<char>(value));
+                else if(value < 0x800) {
+                    buffer.push_back(static_cast<char>(0xC0 | value >> 6));
+                    buffer.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+                } else if(value < 0x10000) {
+                    buffer.push_back(static_cast<char>(0xE0 | value >> 12));
+                    buffer.push_back(static_cast<char>(0x80 | (value >> 6 & 0x3F)));
+                    buffer.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+                } else {
+                    buffer.push_back(static_cast<char>(0xF0 | value >> 18));
+                    buffer.push_back(static_cast<char>(0x80 | (value >> 12 & 0x3F)));
+                    buffer.push_back(static_cast<char>(0x80 | (value >> 6 & 0x3F)));
+                    buffer.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+                }
+                break;
+            }
+            default: return std::nullopt;
+        }
+
+        // Copy characters up to the next quote or escape sequence
+        end = scanString(data, pos);
+        buffer.append(data.substr(pos, end - pos));
+        pos = end;
+    }
+
+    return std::nullopt;
+}
+
+inline std::optional<std::string_view> Parser::parseNumber() {
+    // Find end of number and validate it
+    skipWhitespace();
+    const std::size_t end = std::min(data.find_first_not_of("+-.0123456789eE", pos), data.size());
+    const std::string_view number = data.substr(pos, end - pos);
+    if(!isNumber(number)) return std::nullopt;
+
+    pos = end;
+    return number;
+}
+
+inline std::unique_ptr<Serial> Parser::parseValue(std::string name) {
+    skipWhitespace();
+    if(pos >= data.size()) return nullptr;
+
+    switch(data[pos]) {
+        case '{': return parseObject(std::move(name));
+        case '[': return parseArray(std::move(name));
+        case '"': {
+            const auto str = parseString();
+            if(!str) return nullptr;
+            return std::make_unique<SerialPrimitive>(string::TypeToString<std::string>, std::move(name),
+                                                     string::serializePrimitive(std::string(str.value())));
+        }
+        case 't':
+        case 'f': {
+            const std::string_view value = data.substr(pos, data[pos] == 't' ? 4 : 5);
+            if(value != "true" && value != "false") return nullptr;
+            pos += value.size();
+            return std::make_unique<SerialPrimitive>(string::TypeToString<bool>, std::move(name), std::string(value));
+        }
+        default: {
+            const auto number = parseNumber();
+            if(!number) return nullptr;
+            return std::make_unique<SerialPrimitive>(NUMBER, std::move(name), std::string(number.value()));
+        }
+    }
+}
+
+inline std::unique_ptr<Serial> Parser::parseObject(std::string name) {
+    if(!consume('{')) return nullptr;
+
+    // Parse members (class ids and addresses of objects and pointers are stored in members starting with $)
+    auto object           = std::make_unique<SerialObject>(0, "", 0, 0);
+    unsigned int classID  = 0;
+    Address address       = 0;
+    bool reference        = false;
+    std::vector<std::string> keys;
+    if(!consume('}')) {
+        do {
+            const auto key = parseString();
+            if(!key) return nullptr;
+            std::string member(key.value());
+            if(!consume(':')) return nullptr;
+
+            if(member == "$class" || member == "$id" || member == "$ref") {
+                const auto number = parseNumber();
+                if(!number || number->find_first_of(".eE") != std::string_view::npos) return nullptr;
+
+                if(member == "$class") {
+                    const auto parsedClassID = string::deserializePrimitive<unsigned int>(std::string(number.value()));
+                    if(!parsedClassID) return nullptr;
+                    classID = parsedClassID.value();
+                } else {
+                    const auto parsedAddress = string::deserializePrimitive<Address>(std::string(number.value()));
+                    if(!parsedAddress) return nullptr;
+                    address   = parsedAddress.value();
+                    reference = reference || member == "$ref";
+                }
+            } else {
+                auto child = parseValue(member);
+                if(!child) return nullptr;
+                object->append(std::move(child));
+                keys.push_back(std::move(member));
+            }
+        } while(consume(','));
+        if(!consume('}')) return nullptr;
+    }
+
+    return finishObject(std::move(object), std::move(name), classID, address, reference, keys);
+}
+
+inline std::unique_ptr<Serial> Parser::parseArray(std::string name) {
+    if(!consume('[')) return nullptr;
+
+    // Parse elements named by their index
+    auto array       = std::make_unique<SerialObject>(0, std::move(name), 0, 0);
+    std::size_t size = 0;
+    if(!consume(']')) {
+        do {
+            auto element = parseValue(string::serializePrimitive(size++));
+            if(!element) return nullptr;
+            array->append(std::move(element));
+        } while(consume(','));
+        if(!consume(']')) return nullptr;
+    }
+
+    // Add size (resizable containers expect it)
+    array->append(std::make_unique<SerialPrimitive>(string::TypeToString<std::size_t>, "size",
+                                                    string::serializePrimitive(size)));
+    return array;
+}
+} // namespace json
+
+namespace msgpack {
+inline Writer::Writer(std::span<char> buffer) : buffer(buffer) {}
+
+inline Writer::Writer(std::string& data) : data(&data) {}
+
+inline void Writer::writeBool(bool value) { writeBigEndian(value ? 0xC3 : 0xC2, 0, 0); }
+
+inline void Writer::writeInteger(std::int64_t value) {
+    // Write non-negative values as unsigned, negative values in the smallest type holding them
+    const auto bits = static_cast<std::uint64_t>(value);
+    if(value >= 0) writeUnsigned(bits);
+    else if(value >= -32) writeBigEndian(static_cast<unsigned char>(value), 0, 0);
+    else if(value >= INT8_MIN) writeBigEndian(0xD0, bits, 1);
+    else if(value >= INT16_MIN) writeBigEndian(0xD1, bits, 2);
+    else if(value >= INT32_MIN) writeBigEndian(0xD2, bits, 4);
+    else writeBigEndian(0xD3, bits, 8);
+}
+
+inline void Writer::writeUnsigned(std::uint64_t value) {
+    if(value < 0x80) writeBigEndian(static_cast<unsigned char>(value), 0, 0);
+    else if(value <= UINT8_MAX) writeBigEndian(0xCC, value, 1);
+    else if(value <= UINT16_MAX) writeBigEndian(0xCD, value, 2);
+    else if(value <= UINT32_MAX) writeBigEndian(0xCE, value, 4);
+    else writeBigEndian(0xCF, value, 8);
+}
+
+inline void Writer::writeFloat(float value) { writeBigEndian(0xCA, std::bit_cast<std::uint32_t>(value), 4); }
+
+inline void Writer::writeDouble(double value) { writeBigEndian(0xCB, std::bit_cast<std::uint64_t>(value), 8); }
+
+inline void Writer::writeString(std::string_view str) {
+    if(str.size() < 32) writeBigEndian(static_cast<unsigned char>(0xA0 | str.size()), 0, 0);
+    else if(str.size() <= UINT8_MAX) writeBigEndian(0xD9, str.size(), 1);
+    else if(str.size() <= UINT16_MAX) writeBigEndian(0xDA, str.size(), 2);
+    else writeBigEndian(0xDB, str.size(), 4);
+    write(str);
+}
+
+inline void Writer::writeArray(std::size_t size) {
+    if(size < 16) writeBigEndian(static_cast<unsigned char>(0x90 | size), 0, 0);
+    else if(size <= UINT16_MAX) writeBigEndian(0xDC, size, 2);
+    else writeBigEndian(0xDD, size, 4);
+}
+
+inline void Writer::writeMap(std::size_t size) {
+    if(size < 16) writeBigEndian(static_cast<unsigned char>(0x80 | size), 0, 0);
+    else if(size <= UINT16_MAX) writeBigEndian(0xDE, size, 2);
+    else writeBigEndian(0xDF, size, 4);
+}
+
+inline std::size_t Writer::size() const { return count; }
+
+inline void Writer::write(std::string_view bytes) {
+    // Append to string or copy into the buffer if the bytes fit (the size is counted either way)
+    if(data != nullptr) data->append(bytes);
+    else if(count + bytes.size() <= buffer.size())
+        std::copy(bytes.begin(), bytes.end(), std::next(buffer.begin(), static_cast<std::ptrdiff_t>(count)));
+    count += bytes.size();
+}
+
+inline void Writer::writeBigEndian(unsigned char prefix, std::uint64_t value, std::size_t bytes) {
+    // Write prefix followed by the lowest bytes of the value, most significant first
+    std::array<char, 1 + sizeof(value)> encoded{};
+    encoded[0] = static_cast<char>(prefix);
+    for(std::size_t i = 0; i < bytes; i++) encoded.at(1 + i) = static_cast<char>(value >> (8 * (bytes - 1 - i)) & 0xFF);
+    write(std::string_view(encoded.data(), 1 + bytes));
+}
+
+inline Parser::Parser(std::string_view data) : data(data) {}
+
+inline std::unique_ptr<SerialObject> Parser::parse() {
+    // Parse root map or array (nothing may follow it)
+    auto root = parseValue("root");
+    if(!root || root->asObject() == nullptr || pos != data.size()) return nullptr;
+
+    return std::unique_ptr<SerialObject>(root.release()->asObject());
+}
+
+inline std::optional<std::uint64_t> Parser::readBigEndian(std::size_t bytes) {
+    if(data.size() - pos < bytes) return std::nullopt;
+
+    std::uint64_t value = 0;
+    for(std::size_t i = 0; i < bytes; i++) value = value << 8 | static_cast<unsigned char>(data[pos++]);
+    return value;
+}
+
+inline std::optional<std::uint64_t> Parser::parseUnsigned() {
+    if(pos >= data.size()) return std::nullopt;
+
+    // Positive fixint or uint 8 to 64
+    const auto prefix = static_cast<unsigned char>(data[pos++]);
+    if(prefix < 0x80) return prefix;
+    if(prefix >= 0xCC && prefix <= 0xCF) return readBigEndian(std::size_t{ 1 } << (prefix - 0xCC));
+    return std::nullopt;
+}
+
+inline std::optional<std::string_view> Parser::parseString() {
+    if(pos >= data.size()) return std::nullopt;
+
+    // Fixstr or str 8 to 32
+    const auto prefix = static_cast<unsigned char>(data[pos++]);
+    std::optional<std::uint64_t> size;
+    if((prefix & 0xE0) == 0xA0) size = prefix & 0x1F;
+    else if(prefix >= 0xD9 && prefix <= 0xDB) size = readBigEndian(std::size_t{ 1 } << (prefix - 0xD9));
+    if(!size || data.size() - pos < size.value()) return std::nullopt;
+
+    const std::string_view str = data.substr(pos, size.value());
+    pos += size.value();
+    return str;
+}
+
+inline std::unique_ptr<Serial> Parser::parseValue(std::string name) {
+    if(pos >= data.size()) return nullptr;
+    const auto prefix = static_cast<unsigned char>(data[pos]);
+    const auto number = [&name](std::string value) {
+        return std::make_unique<SerialPrimitive>(json::NUMBER, std::move(name), std::move(value));
+    };
+
+    // Strings and unsigned integers
+    if((prefix & 0xE0) == 0xA0 || (prefix >= 0xD9 && prefix <= 0xDB)) {
+        const auto str = parseString();
+        if(!str) return nullptr;
+        return std::make_unique<SerialPrimitive>(string::TypeToString<std::string>, std::move(name),
+                                                 string::serializePrimitive(std::string(str.value())));
+    }
+    if(prefix < 0x80 || (prefix >= 0xCC && prefix <= 0xCF)) {
+        const auto value = parseUnsigned();
+        if(!value) return nullptr;
+        return number(string::serializePrimitive(static_cast<unsigned long>(value.value())));
+    }
+    pos++;
+
+    // Maps and arrays
+    if((prefix & 0xF0) == 0x80) return parseMap(std::move(name), prefix & 0x0F);
+    if((prefix & 0xF0) == 0x90) return parseArray(std::move(name), prefix & 0x0F);
+    if(prefix >= 0xDC && prefix <= 0xDF) {
+        const auto size = readBigEndian(prefix == 0xDC || prefix == 0xDE ? 2 : 4);
+        if(!size) return nullptr;
+        if(prefix <= 0xDD) return parseArray(std::move(name), size.value());
+        return parseMap(std::move(name), size.value());
+    }
+
+    // Negative fixint or int 8 to 64 (sign extended)
+    if(prefix >= 0xE0) return number(string::serializePrimitive(static_cast<long>(static_cast<signed char>(prefix))));
+    if(prefix >= 0xD0 && prefix <= 0xD3) {
+        const std::size_t bytes = std::size_t{ 1 } << (prefix - 0xD0);
+        const auto value        = readBigEndian(bytes);
+        if(!value) return nullptr;
+        const std::size_t shift = 64 - 8 * bytes;
+        return number(string::serializePrimitive(static_cast<long>(static_cast<std::int64_t>(value.value() << shift) >>
+                                                                    shift)));
+    }
+
+    // Booleans
+    if(prefix == 0xC2 || prefix == 0xC3)
+        return std::make_unique<SerialPrimitive>(string::TypeToString<bool>, std::move(name),
+                                                 string::serializePrimitive(prefix == 0xC3));
+
+    // Floats (always written with a fraction, exponent, nan or inf, so integers don't accept them)
+    if(prefix == 0xCA || prefix == 0xCB) {
+        const auto bits = readBigEndian(prefix == 0xCA ? 4 : 8);
+        if(!bits) return nullptr;
+        std::array<char, 32> buffer{};
+        const auto single   = std::bit_cast<float>(static_cast<std::uint32_t>(bits.value()));
+        const auto dual     = std::bit_cast<double>(bits.value());
+        const auto [end, _] = prefix == 0xCA ? std::to_chars(buffer.begin(), buffer.end(), single)
+                                             : std::to_chars(buffer.begin(), buffer.end(), dual);
+        std::string value(buffer.begin(), end);
+        if(value.find_first_of(".eEn") == std::string::npos) value.append(".0");
+        return number(std::move(value));
+    }
+
+    // Nil, binary data and extensions have no serial equivalent
+    return nullptr;
+}
+
+inline std::unique_ptr<Serial> Parser::parseMap(std::string name, std::size_t size) {
+    // Parse members (class ids and addresses of objects and pointers are stored in members starting with $)
+    auto object          = std::make_unique<SerialObject>(0, "", 0, 0);
+    unsigned int classID = 0;
+    Address address      = 0;
+    bool reference       = false;
+    std::vector<std::string> keys;
+    for(std::size_t index = 0; index < size; index++) {
+        const auto key = parseString();
+        if(!key) return nullptr;
+        std::string member(key.value());
+
+        if(member == "$class" || member == "$id" || member == "$ref") {
+            const auto number = parseUnsigned();
+            if(!number) return nullptr;
+
+            if(member == "$class") {
+                if(number.value() > UINT_MAX) return nullptr;
+                classID = static_cast<unsigned int>(number.value());
+            } else {
+                address   = number.value();
+                reference = reference || member == "$ref";
+            }
+        } else {
+            auto child = parseValue(member);
+            if(!child) return nullptr;
+            object->append(std::move(child));
+            keys.push_back(std::move(member));
+        }
+    }
+
+    return json::finishObject(std::move(object), std::move(name), classID, address, reference, keys);
+}
+
+inline std::unique_ptr<Serial> Parser::parseArray(std::string name, std::size_t size) {
+    // Parse elements named by their index (objects read positionally look up their members by index too)
+    auto array = std::make_unique<SerialObject>(0, std::move(name), 0, 0);
+    array->setPositional(true);
+    for(std::size_t index = 0; index < size; index++) {
+        auto element = parseValue(string::serializePrimitive(index));
+        if(!element) return nullptr;
+        array->append(std::move(element));
+    }
+
+    // Add size (resizable containers expect it)
+    array->append(std::make_unique<SerialPrimitive>(string::TypeToString<std::size_t>, "size",
+                                                    string::serializePrimitive(size)));
+    return array;
+}
+} // namespace msgpack
+} // namespace detail
+
+inline unsigned char LZCodec::id() const { return 1; }
+
+// Sequences: TOKEN [LITERAL_LENGTH] LITERALS [OFFSET [MATCH_LENGTH]], the last sequence has no match
+inline std::string LZCodec::compress(std::string_view data) const {
+    static const constexpr std::size_t HASH_BITS = 14, MIN_MATCH = 4, MAX_OFFSET = 0xFFFF;
+
+    // Create output string
+    std::string compressed;
+    compressed.reserve(data.size() / 2 + 16);
+
+    // Helpers for reading sequences of four bytes and writing sequences
+    const auto read = [&data](std::size_t pos) {
+        std::uint32_t value = 0;
+        std::memcpy(&value, &data[pos], sizeof(value));
+        return value;
+    };
+
+    const auto writeLength = [&compressed](std::size_t length) {
+        for(; length >= 255; length -= 255) compressed.push_back(static_cast<char>(255));
+        compressed.push_back(static_cast<char>(length));
+    };
+
+    const auto writeSequence = [&](std::string_view literals, std::size_t offset, std::size_t length) {
+        // Write token (high nibble: literal length, low nibble: match length, 15: continued in extra bytes)
+        const std::size_t matchLength = offset == 0 ? 0 : length - MIN_MATCH;
+        compressed.push_back(static_cast<char>(std::min<std::size_t>(literals.size(), 15) << 4 |
+                                               std::min<std::size_t>(matchLength, 15)));
+
+        // Write literals
+        if(literals.size() >= 15) writeLength(literals.size() - 15);
+        compressed.append(literals);
+
+        // Write match
+        if(offset == 0) return;
+        compressed.push_back(static_cast<char>(offset & 0xFF));
+        compressed.push_back(static_cast<char>(offset >> 8));
+        if(matchLength >= 15) writeLength(matchLength - 15);
+    };
+
+    // Find matches through a hash table of the last position (+ 1) of every sequence of four bytes
+    std::vector<std::uint32_t> table(1 << HASH_BITS);
+    std::size_t anchor = 0, pos = 0;
+    while(pos + MIN_MATCH <= data.size()) {
+        // Look up and update candidate
+        const std::uint32_t sequence = read(pos);
+        const std::size_t hash       = (sequence * 2654435761U) >> (32 - HASH_BITS);
+        const std::size_t candidate  = table[hash];
+        table[hash]                  = pos + 1;
+
+        // Check candidate
+        if(candidate == 0 || pos + 1 - candidate > MAX_OFFSET || read(candidate - 1) != sequence) {
+            pos++;
+            continue;
+        }
+
+        // Extend match
+        const std::size_t match = candidate - 1;
+        std::size_t length      = MIN_MATCH;
+        while(pos + length < data.size() && data[match + length] == data[pos + length]) length++;
+
+        // Write sequence
+        writeSequence(data.substr(anchor, pos - anchor), pos - match, length);
+        pos += length;
+        anchor = pos;
+    }
+
+    // Write remaining literals
+    writeSequence(data.substr(anchor), 0, 0);
+
+    return compressed;
+}
+
+inline std::optional<std::string> LZCodec::decompress(std::string_view data, std::size_t size) const {
+    static const constexpr std::size_t MIN_MATCH = 4;
+
+    // Create output string
+    std::string decompressed(size, '\0');
+    std::size_t written = 0, pos = 0;
+
+    // Helper for reading extra length bytes
+    const auto readLength = [&data, &pos](std::size_t& length) {
+        while(pos < data.size()) {
+            const auto byte = static_cast<unsigned char>(data[pos++]);
+            length += byte;
+            if(byte != 255) return true;
+        }
+        return false;
+    };
+
+    while(pos < data.size()) {
+        // Read token
+        const auto token     = static_cast<unsigned char>(data[pos++]);
+        std::size_t literals = token >> 4;
+        std::size_t length   = token & 0x0F;
+
+        // Copy literals
+        if(literals == 15 && !readLength(literals)) return std::nullopt;
+        if(literals > data.size() - pos || literals > size - written) return std::nullopt;
+        std::memcpy(&decompressed[written], &data[pos], literals);
+        written += literals;
+        pos += literals;
+
+        // Stop after the last sequence
+        if(pos == data.size()) break;
+
+        // Read match
+        if(data.size() - pos < 2) return std::nullopt;
+        const std::size_t offset = static_cast<std::size_t>(static_cast<unsigned char>(data[pos])) |
+                                   static_cast<std::size_t>(static_cast<unsigned char>(data[pos + 1])) << 8;
+        pos += 2;
+        if(length == 15 && !readLength(length)) return std::nullopt;
+        length += MIN_MATCH;
+        if(offset == 0 || offset > written || length > size - written) return std::nullopt;
+
+        // Copy match (byte by byte if it overlaps itself)
+        if(offset >= length) std::memcpy(&decompressed[written], &decompressed[written - offset], length);
+        else
+            for(std::size_t i = 0; i < length; i++) decompressed[written + i] = decompressed[written - offset + i];
+        written += length;
+    }
+
+    // Check size
+    if(written != size) return std::nullopt;
+    return decompressed;
+}
+
+#if defined(SERIALIZABLE_ZLIB)
+inline unsigned char ZlibCodec::id() const { return 2; }
+
+inline std::string ZlibCodec::compress(std::string_view data) const {
+    // Compress into buffer of maximum size
+    uLongf size = compressBound(data.size());
+    std::string compressed(size, '\0');
+    if(compress2(std::bit_cast<Bytef*>(compressed.data()), &size, std::bit_cast<const Bytef*>(data.data()),
+                 data.size(), Z_BEST_SPEED) != Z_OK)
+        return "";
+
+    // Shrink to actual size
+    compressed.resize(size);
+    return compressed;
+}
+
+inline std::optional<std::string> ZlibCodec::decompress(std::string_view data, std::size_t size) const {
+    // Decompress and check size
+    uLongf decompressedSize = size;
+    std::string decompressed(size, '\0');
+    if(uncompress(std::bit_cast<Bytef*>(decompressed.data()), &decompressedSize,
+                  std::bit_cast<const Bytef*>(data.data()), data.size()) != Z_OK)
+        return std::nullopt;
+    if(decompressedSize != size) return std::nullopt;
+
+    return decompressed;
+}
+#endif
+
+#if defined(SERIALIZABLE_ZSTD)
+inline unsigned char ZstdCodec::id() const { return 3; }
+
+inline std::string ZstdCodec::compress(std::string_view data) const {
+    // Compress into buffer of maximum size
+    std::string compressed(ZSTD_compressBound(data.size()), '\0');
+    const std::size_t size = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), 1);
+    if(ZSTD_isError(size) != 0) return "";
+
+    // Shrink to actual size
+    compressed.resize(size);
+    return compressed;
+}
+
+inline std::optional<std::string> ZstdCodec::decompress(std::string_view data, std::size_t size) const {
+    // Decompress and check size
+    std::string decompressed(size, '\0');
+    const std::size_t decompressedSize = ZSTD_decompress(decompressed.data(), size, data.data(), data.size());
+    if(ZSTD_isError(decompressedSize) != 0 || decompressedSize != size) return std::nullopt;
+
+    return decompressed;
+}
+#endif
+
+inline void registerCodec(std::shared_ptr<const Codec> codec) {
+    // Codecs may be registered while other threads load files
+    const std::scoped_lock lock(detail::codecsMutex());
+    detail::codecs()[codec->id()] = std::move(codec);
+}
+
+inline std::pair<Serializable::Result, std::string> Serializable::serialize(const Options& options) {
+    // Encode data
+    auto [result, data] = encode(options);
+    if(result != Result::OK) return { result, "" };
+
+    // Prepend header to everything except text and JSON
+    if(!detail::frame::hasHeader(options.format)) return { Result::OK, std::move(data) };
+    return { Result::OK, detail::frame::makeHeader(options.format, 0) + data };
+}
+
+inline std::pair<Serializable::Result, std::size_t> Serializable::serialize(std::span<char> buffer,
+                                                                            const Options& options) {
+    // Write MessagePack directly into the buffer
+    if(options.format == Options::Format::MSGPACK) {
+        const Result collected = collect(options);
+        if(collected != Result::OK) return { collected, 0 };
+        detail::msgpack::Writer writer(buffer);
+        serial->getMsgPack(writer, options.positional);
+        return { Result::OK, writer.size() };
+    }
+
+    // Copy other formats into the buffer (if they fit)
+    const auto [result, data] = serialize(options);
+    if(result != Result::OK) return { result, 0 };
+    if(data.size() <= buffer.size()) std::copy(data.begin(), data.end(), buffer.begin());
+    return { Result::OK, data.size() };
+}
+
+inline Serializable::Result Serializable::deserialize(std::string_view data, const Options& options) {
+    validate  = options.validate;
+    sparse    = options.sparse;
+    bitfields = options.bitfields;
+
+    // Read data with header
+    if(data.starts_with(detail::frame::MAGIC)) {
+        std::istringstream stream{ std::string(data) };
+        return read(stream);
+    }
+
+    // Decode headerless text, JSON or MessagePack
+    return decode(detail::frame::detectFormat(data), data);
+}
+
+inline Serializable::Result Serializable::save(const std::filesystem::path& path, const Options& options) {
+    // Create parent path
+    if(path.has_parent_path()) std::filesystem::create_directories(path.parent_path());
+
+    // Encode data
+    const auto [result, data] = encode(options);
+    if(result != Result::OK) return result;
+
+    // Skip files known to hold the data (by a fingerprint of the data and the options framing it, before framing)
+    std::uint64_t fingerprint = 0;
+    if(options.skipUnchanged) {
+        fingerprint      = detail::frame::fingerprintData(data, options);
+        const auto saved = detail::frame::isSaved(path, fingerprint);
+        if(saved.value_or(false)) return Result::OK;
+
+        // Frame data in memory to compare it with files not saved by this process (or modified since)
+        if(!saved) {
+            std::ostringstream framed;
+            if(!detail::frame::writeData(framed, data, options)) return Result::FILE;
+            const std::string file = framed.str();
+            if(!detail::frame::holdsFile(path, file)) {
+                std::ofstream stream(path, std::ios::binary);
+                if(!stream || !stream.write(file.data(), static_cast<std::streamsize>(file.size())))
+                    return Result::FILE;
+                stream.close();
+            }
+            detail::frame::setSaved(path, fingerprint);
+            return Result::OK;
+        }
+    }
+
+    // Open and check file
+    std::ofstream stream(path, std::ios::binary);
+    if(!stream) return Result::FILE;
+
+    // Write header and data
+    if(!detail::frame::writeData(stream, data, options)) return Result::FILE;
+    stream.close();
+
+    // Finish
+    if(options.skipUnchanged) detail::frame::setSaved(path, fingerprint);
+    return Result::OK;
+}
+
+inline Serializable::Result Serializable::load(const std::filesystem::path& path, const Options& options) {
+    validate  = options.validate;
+    sparse    = options.sparse;
+    bitfields = options.bitfields;
+
+    // Open and check file
+    std::ifstream stream(path, std::ios::binary);
+    if(!stream) return Result::FILE;
+
+    // Read data
+    return read(stream);
+}
+
+inline std::pair<Serializable::Result, std::uint64_t> Serializable::fingerprint() {
+    // Setup fingerprinting state (maps are fed sorted, so equal state always has the same fingerprint)
+    detail::fingerprint::State state;
+    mode      = Mode::FINGERPRINTING;
+    result    = Result::OK;
+    format    = Options::Format::TEXT;
+    sparse    = false;
+    bitfields = false;
+    canonical = true;
+    bits      = {};
+    serial    = nullptr;
+    hashing   = &state;
+    if(classID() != 0) state.addresses[std::bit_cast<detail::Address>(this)] = 1;
+    state.hasher.updateValue(classID());
+
+    // Run exposers
+    exposed();
+    hashing = nullptr;
+    if(result != Result::OK) return { result, 0 };
+
+    // Feed pointers as the virtual addresses of their targets (stable across runs, unlike real addresses)
+    for(const detail::Address target : state.targets) {
+        const auto address = state.addresses.find(target);
+        if(address == state.addresses.end()) return { Result::POINTER, 0 };
+        state.hasher.updateValue(address->second);
+    }
+
+    return { Result::OK, state.hasher.digest() };
+}
+
+inline Serializable::Result Serializable::collect(const Options& options) {
+    // Setup serialization state
+    mode   = Mode::SERIALIZING;
+    result = Result::OK;
+    format = options.format;
+    sparse    = options.sparse && !(options.format == Options::Format::MSGPACK && options.positional);
+    bitfields = options.bitfields && options.format == Options::Format::MSGPACK && options.positional;
+    canonical = options.canonical;
+    bits      = {};
+    serial = std::make_unique<detail::SerialObject>(classID(), "root", std::bit_cast<detail::Address>(this), 0);
+
+    // Run exposers
+    exposed();
+    if(result != Result::OK) return result;
+
+    // Virtualize addresses
+    std::unordered_map<detail::Address, detail::Address> addressMap;
+    serial->asObject()->virtualizeAddresses(addressMap);
+    if(!serial->asObject()->virtualizePointers(addressMap)) return Result::POINTER;
+
+    return Result::OK;
+}
+
+inline std::pair<Serializable::Result, std::string> Serializable::encode(const Options& options) {
+    // Collect serial objects
+    const Result collected = collect(options);
+    if(collected != Result::OK) return { collected, "" };
+
+    // Write JSON or MessagePack
+    if(options.format == Options::Format::JSON) {
+        std::string data;
+        serial->getJSON(data);
+        return { Result::OK, std::move(data) };
+    }
+    if(options.format == Options::Format::MSGPACK) {
+        std::string data;
+        detail::msgpack::Writer writer(data);
+        serial->getMsgPack(writer, options.positional);
+        return { Result::OK, std::move(data) };
+    }
+
+    // Write text
+    std::string data = prepareText(options);
+    data.append(serial->get(options.compact, options.inlining));
+    return { Result::OK, std::move(data) };
+}
+
+inline std::string Serializable::prepareText(const Options& options) {
+    // Replace objects identical to an earlier one by references to it
+    if(options.references) {
+        std::unordered_map<std::string, std::pair<std::size_t, std::string>> originals;
+        std::string key;
+        static_cast<void>(serial->asObject()->referenceObjects(originals, "", key));
+    }
+
+    // Write without dictionary (text starts with its version)
+    std::string data = detail::string::makeString(std::string(detail::string::VERSION), "\n");
+    if(!options.dictionary) return data;
+
+    // Collect repeated strings, most frequent first
+    std::unordered_map<std::string, std::size_t> counts;
+    serial->asObject()->countStrings(counts);
+    std::vector<std::pair<std::string, std::size_t>> repeated;
+    for(const auto& [value, count] : counts)
+        if(count > 1) repeated.emplace_back(value, count);
+    std::sort(repeated.begin(), repeated.end(), [](const auto& a, const auto& b) {
+        return a.second == b.second ? a.first < b.first : a.second > b.second;
+    });
+
+    // Build dictionary and replace strings with references
+    std::unordered_map<std::string, std::size_t> indices;
+    std::vector<std::string> entries;
+    for(const auto& [value, count] : repeated) {
+        // Skip strings where references don't save more than the dictionary entry costs
+        const std::size_t index     = entries.size();
+        const std::size_t reference = 1 + detail::string::serializePrimitive(index).size();
+        if(value.size() <= reference || count * (value.size() - reference) <= value.size() + 2) continue;
+
+        indices[value] = index;
+        entries.push_back(value);
+    }
+    serial->asObject()->referenceStrings(indices);
+
+    // Prepend dictionary block (compact data is not indented)
+    if(!entries.empty()) {
+        const std::string opening = options.compact ? "STRINGS{\n" : "STRINGS {\n";
+        const std::string block   = options.compact ? detail::string::connect(entries)
+                                                    : detail::string::indent(detail::string::connect(entries));
+        data.append(opening).append(block).append("\n}\n");
+    }
+    return data;
+}
+
+inline Serializable::Result Serializable::decode(Options::Format format, std::string_view data) {
+    // Parse data and run exposers
+    const Result parsed = parse(format, data);
+    if(parsed != Result::OK) return parsed;
+    return decodeSerial();
+}
+
+inline Serializable::Result Serializable::parse(Options::Format format, std::string_view data) {
+    // Setup deserialization state
+    mode         = Mode::DESERIALIZING;
+    result       = Result::OK;
+    this->format = format;
+    serial       = std::make_unique<detail::SerialObject>();
+    dictionary   = nullptr;
+    legacy       = false;
+    bits         = {};
+
+    // Parse JSON or MessagePack
+    if(format == Options::Format::JSON || format == Options::Format::MSGPACK) {
+        auto root = format == Options::Format::JSON ? detail::json::Parser(data).parse()
+                                                    : detail::msgpack::Parser(data).parse();
+        if(!root) return Result::STRUCTURE;
+        serial = std::move(root);
+        return Result::OK;
+    }
+    if(format != Options::Format::TEXT) return Result::STRUCTURE;
+
+    // Read version (text without one uses entities instead of escape sequences, newer versions can not be read)
+    legacy = !data.starts_with("VERSION ");
+    if(!legacy) {
+        const std::size_t newline = data.find('\n');
+        if(data.substr(0, newline) != detail::string::VERSION) return Result::STRUCTURE;
+        data.remove_prefix(newline + 1);
+    }
+
+    // Parse string dictionary (decoding every entry once)
+    const std::string text(data);
+    const auto parsedDictionary = detail::string::parseDictionary(text);
+    if(parsedDictionary) {
+        const bool compact = data.starts_with("STRINGS{");
+        const auto lines   = compact ? parsedDictionary->at(0) : detail::string::unindent(parsedDictionary->at(0));
+        auto entries       = std::make_shared<std::vector<std::string>>();
+        for(const auto& entry : detail::string::split(lines)) {
+            auto value = legacy ? detail::string::deserializeLegacyString(entry)
+                                : detail::string::deserializePrimitive<std::string>(entry);
+            if(!value) return Result::STRUCTURE;
+            if(validate && !detail::string::isUTF8(value.value())) return Result::ENCODING;
+            entries->push_back(std::move(value.value()));
+        }
+        dictionary = std::move(entries);
+    }
+
+    // Parse serialized data
+    if(!serial->set(parsedDictionary ? parsedDictionary->at(1) : text)) return Result::STRUCTURE;
+
+    // Expand references to identical objects
+    std::unordered_set<const detail::SerialObject*> resolving;
+    if(text.find(detail::string::REFERENCE) != std::string::npos &&
+       !serial->asObject()->resolveReferences(*serial->asObject(), resolving))
+        return Result::STRUCTURE;
+    return Result::OK;
+}
+
+inline Serializable::Result Serializable::restore(std::unique_ptr<detail::Serial> root) {
+    // Setup deserialization state for a parsed text snapshot
+    mode       = Mode::DESERIALIZING;
+    result     = Result::OK;
+    format     = Options::Format::TEXT;
+    serial     = std::move(root);
+    dictionary = nullptr;
+    legacy     = false;
+    bits       = {};
+
+    return decodeSerial();
+}
+
+inline Serializable::Result Serializable::decodeSerial() {
+    // Check root object class id (read from the first elements of positional objects)
+    position = serial->asObject()->resolvePosition(classID());
+    if(serial->asObject()->getClass() != classID()) return Result::TYPECHECK;
+
+    // Run exposers
+    exposed();
+    if(result != Result::OK) return result;
+
+    // Restore addresses
+    serial->asObject()->setRealAddress(std::bit_cast<detail::Address>(this));
+    std::unordered_map<detail::Address, detail::Address> addressMap;
+    serial->asObject()->restoreAddresses(addressMap);
+    if(!serial->asObject()->restorePointers(addressMap)) return Result::POINTER;
+
+    return Result::OK;
+}
+
+inline Serializable::Result Serializable::read(std::istream& stream) {
+    // Read headerless text, JSON or MessagePack
+    if(!detail::frame::detect(stream)) {
+        std::stringstream str;
+        str << stream.rdbuf();
+        const std::string data = str.str();
+        return decode(detail::frame::detectFormat(data), data);
+    }
+
+    // Read header
+    const auto header = detail::frame::readHeader(stream);
+    if(!header) return Result::STRUCTURE;
+
+    // Read data stored in blocks
+    if((header->flags & detail::frame::BLOCKS) != 0) {
+        const auto [result, data] = detail::frame::readBlocks(stream);
+        if(result != Result::OK) return result;
+        return decode(header->format, data);
+    }
+
+    // Read remaining data
+    std::stringstream str;
+    str << stream.rdbuf();
+    return decode(header->format, str.str());
+}
+
+inline std::optional<detail::Serial*> Serializable::find(const std::string& name) {
+    // Objects read positionally find their members in the order of exposure (containers find elements by index)
+    const auto* object = serial->asObject();
+    if(object->isPositional() && !container) return object->getChild(detail::string::serializePrimitive(position++));
+    return object->getChild(name);
+}
+
+inline unsigned int Serializable::classID() const { return 0; }
+
+inline Serializable::Quantization Serializable::Quantization::fixed(double scale, unsigned int bits) {
+    return { Type::FIXED, scale, std::clamp(bits, 1U, 32U) };
+}
+
+inline Serializable::Quantization Serializable::Quantization::half() { return { Type::HALF }; }
+
+inline bool Serializable::Quantization::isValid() const {
+    // Fixed point numbers need a positive scale whose inverse is finite too
+    return type != Type::FIXED || (std::isnormal(scale) && scale > 0);
+}
+
+template <detail::SerializablePrimitive P> void Serializable::expose(const std::string& name, P& value) {
+    // Abort if a previous error was detected
+    if(result != Result::OK) return;
+
+    // Feed name and value into the fingerprint (strings by their characters, others by their bytes)
+    if(mode == Mode::FINGERPRINTING) {
+        hashing->hasher.updateValue(detail::fingerprint::VALUE);
+        hashing->hasher.updateString(name);
+        if constexpr(std::is_same_v<P, std::string>) hashing->hasher.updateString(value);
+        else hashing->hasher.updateValue(value);
+        return;
+    }
+
+    // Pack bools and enums of positional objects into bit fields (not those of containers, which are read by index)
+    if constexpr(std::is_same_v<P, bool> || detail::Enum<P>) {
+        if(bitfields && !container && (mode == Mode::SERIALIZING || serial->asObject()->isPositional())) {
+            exposeBits(name, value);
+            return;
+        }
+    }
+
+    if(mode == Mode::SERIALIZING) {
+        // Append new serial primitive to root
+        serial->asObject()->append(std::make_unique<detail::SerialPrimitive>(
+          detail::string::TypeToString<P>, name, detail::string::serializePrimitive(value)));
+    } else {
+        // Find serial value in root object
+        const auto serialValue = find(name);
+        if(!serialValue) {
+            result = Result::INTEGRITY;
+            return;
+        }
+
+        // Convert to serial primitive
+        const auto* serialPrimitive = serialValue.value()->asPrimitive();
+        if(serialPrimitive == nullptr) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Check primitive type (untyped JSON numbers are checked against the exposed type)
+        const auto typedValue = detail::json::typedValue<P>(serialPrimitive->getType(), serialPrimitive->getValue());
+        if(!typedValue) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Resolve string references from the dictionary
+        if constexpr(std::is_same_v<P, std::string>) {
+            if(serialPrimitive->getValue().starts_with('@')) {
+                const auto index = detail::string::deserializePrimitive<unsigned long>(
+                  serialPrimitive->getValue().substr(1));
+                if(!index || dictionary == nullptr || index.value() >= dictionary->size()) {
+                    result = Result::TYPECHECK;
+                    return;
+                }
+
+                value = dictionary->at(index.value());
+                return;
+            }
+        }
+
+        // Get primitive value
+        std::optional<P> primitiveValue;
+        if constexpr(std::is_same_v<P, std::string>) {
+            primitiveValue = legacy ? detail::string::deserializeLegacyString(typedValue.value())
+                                    : detail::string::deserializePrimitive<P>(typedValue.value());
+        } else primitiveValue = detail::string::deserializePrimitive<P>(typedValue.value());
+        if(!primitiveValue) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Check encoding of strings
+        if constexpr(std::is_same_v<P, std::string>) {
+            if(validate && !detail::string::isUTF8(primitiveValue.value())) {
+                result = Result::ENCODING;
+                return;
+            }
+        }
+
+        // Set value
+        value = primitiveValue.value();
+    }
+}
+
+template <detail::SerializablePrimitive P>
+void Serializable::expose(const std::string& name, P& value, const std::type_identity_t<P>& defaultValue) {
+    // Abort if a previous error was detected
+    if(result != Result::OK) return;
+
+    // Omit values equal to their default, read missing values as it (objects read positionally have every value)
+    if(sparse && mode == Mode::SERIALIZING && value == defaultValue) return;
+    if(sparse && mode == Mode::DESERIALIZING && !serial->asObject()->isPositional() &&
+       !serial->asObject()->getChild(name)) {
+        value = defaultValue;
+        return;
+    }
+
+    expose(name, value);
+}
+
+template <std::floating_point F>
+void Serializable::expose(const std::string& name, F& value, Quantization quantization) {
+    // Abort if a previous error was detected
+    if(result != Result::OK) return;
+
+    // Values are read and fingerprinted as they are, only the written value is quantized
+    if(mode != Mode::SERIALIZING || quantization.type == Quantization::Type::NONE) {
+        expose(name, value);
+        return;
+    }
+    if(!quantization.isValid()) {
+        result = Result::TYPECHECK;
+        return;
+    }
+
+    // Write the value closest to the original one that survives quantization
+    F quantized = value;
+    if(quantization.type == Quantization::Type::FIXED) {
+        std::int32_t code = 0;
+        detail::packing::quantize(std::span<const F>(&value, 1), quantization.scale, quantization.bits,
+                                  std::span(&code, 1));
+        detail::packing::dequantize(std::span<const std::int32_t>(&code, 1), quantization.scale,
+                                    std::span(&quantized, 1));
+    } else quantized = static_cast<F>(detail::packing::fromHalf(detail::packing::toHalf(static_cast<float>(value))));
+    expose(name, quantized);
+}
+
+template <detail::SerializablePrimitive P> void Serializable::exposeBits(const std::string& name, P& value) {
+    using Word = detail::packing::Word;
+
+    // Find width (enums use their declared maximum or every bit of their underlying type)
+    unsigned int width = 1;
+    if constexpr(detail::Enum<P>) {
+        using U = std::make_unsigned_t<std::underlying_type_t<P>>;
+        if constexpr(EnumMaximum<P>.has_value())
+            width = std::max(1U, static_cast<unsigned int>(std::bit_width(static_cast<U>(EnumMaximum<P>.value()))));
+        else width = sizeof(U) * CHAR_BIT;
+    }
+    const Word mask = width == sizeof(Word) * CHAR_BIT ? ~Word{} : (Word{ 1 } << width) - 1;
+    const bool full = bits.used + width > sizeof(Word) * CHAR_BIT;
+
+    if(mode == Mode::SERIALIZING) {
+        // Take bits of the value (enums beyond their declared maximum don't fit)
+        Word field = 0;
+        if constexpr(detail::Enum<P>) field = static_cast<std::make_unsigned_t<std::underlying_type_t<P>>>(value);
+        else field = value ? 1 : 0;
+        if(field > mask) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Start a new word unless the current one is the last member and has room left
+        if(bits.word == nullptr || serial->asObject()->getLast() != bits.word || full) {
+            auto word = std::make_unique<detail::SerialPrimitive>(
+              detail::string::TypeToString<Word>, "$bits" + detail::string::serializePrimitive(bits.count++), "0");
+            bits.word  = word.get();
+            bits.value = 0;
+            bits.used  = 0;
+            serial->asObject()->append(std::move(word));
+        }
+
+        // Add bits of the value
+        bits.value |= field << bits.used;
+        bits.used += width;
+        bits.word->setValue(detail::string::serializePrimitive(bits.value));
+    } else {
+        // Read a new word unless the current one was the last member read and has bits left
+        if(bits.used == 0 || position != bits.position || full) {
+            const auto serialValue = find(name);
+            if(!serialValue) {
+                result = Result::INTEGRITY;
+                return;
+            }
+            // Convert to unsigned integer (untyped MessagePack numbers are checked against it)
+            const auto* serialPrimitive = serialValue.value()->asPrimitive();
+            std::optional<Word> word;
+            if(serialPrimitive != nullptr) {
+                const auto typedValue = detail::json::typedValue<Word>(serialPrimitive->getType(),
+                                                                       serialPrimitive->getValue());
+                if(typedValue) word = detail::string::deserializePrimitive<Word>(typedValue.value());
+            }
+            if(!word) {
+                result = Result::TYPECHECK;
+                return;
+            }
+            bits.position = position;
+            bits.value    = word.value();
+            bits.used     = 0;
+        }
+
+        // Take bits of the value
+        const Word field = bits.value >> bits.used & mask;
+        bits.used += width;
+        if constexpr(detail::Enum<P>) {
+            using U = std::make_unsigned_t<std::underlying_type_t<P>>;
+            value   = static_cast<P>(static_cast<std::underlying_type_t<P>>(static_cast<U>(field)));
+        } else value = field != 0;
+    }
+}
+
+inline void Serializable::expose(const std::string& name, Serializable& value) {
+    // Abort if previous error was detected
+    if(result != Result::OK) return;
+
+    if(mode == Mode::FINGERPRINTING) {
+        // Number objects with class id like their virtual addresses (only below objects with class id)
+        if(value.classID() != 0 && hashing->addresses.contains(std::bit_cast<detail::Address>(this)))
+            hashing->addresses.try_emplace(std::bit_cast<detail::Address>(&value), hashing->addresses.size() + 1);
+
+        // Fingerprint object between its name and an end tag
+        hashing->hasher.updateValue(detail::fingerprint::OBJECT);
+        hashing->hasher.updateString(name);
+        hashing->hasher.updateValue(value.classID());
+        value.mode      = Mode::FINGERPRINTING;
+        value.result    = Result::OK;
+        value.format    = format;
+        value.sparse    = sparse;
+        value.bitfields = bitfields;
+        value.canonical = canonical;
+        value.bits      = {};
+        value.serial    = nullptr;
+        value.hashing   = hashing;
+        value.exposed();
+        value.hashing = nullptr;
+        hashing->hasher.updateValue(detail::fingerprint::END);
+
+        // Take result
+        if(value.result != result) result = value.result;
+        return;
+    }
+
+    if(mode == Mode::SERIALIZING) {
+        // Serialize object
+        value.mode      = Mode::SERIALIZING;
+        value.result    = Result::OK;
+        value.format    = format;
+        value.sparse    = sparse;
+        value.bitfields = bitfields;
+        value.canonical = canonical;
+        value.bits      = {};
+        auto object =
+          std::make_unique<detail::SerialObject>(value.classID(), name, std::bit_cast<detail::Address>(&value), 0);
+        object->setContainer(value.container);
+        value.serial = std::move(object);
+        value.exposed();
+
+        // Take result
+        if(value.result != result) {
+            result = value.result;
+            return;
+        }
+
+        // Append serial object to root
+        serial->asObject()->append(std::move(value.serial));
+    } else {
+        // Find serial value in root object
+        const auto serialValue = find(name);
+        if(!serialValue) {
+            result = Result::INTEGRITY;
+            return;
+        }
+
+        // Convert to serial object
+        auto* serialObject = serialValue.value()->asObject();
+        if(serialObject == nullptr) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Check class id (read from the first elements of positional objects)
+        const std::size_t position = serialObject->resolvePosition(value.classID());
+        if(serialObject->getClass() != value.classID()) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Set objects real address
+        serialObject->setRealAddress(std::bit_cast<detail::Address>(&value));
+
+        // Deserialize object
+        value.mode       = Mode::DESERIALIZING;
+        value.result     = Result::OK;
+        value.format     = format;
+        value.validate   = validate;
+        value.sparse     = sparse;
+        value.bitfields  = bitfields;
+        value.legacy     = legacy;
+        value.serial     = serialObject->clone();
+        value.dictionary = dictionary;
+        value.position   = position;
+        value.bits       = {};
+        value.exposed();
+
+        // Take result
+        if(value.result != result) {
+            result = value.result;
+            return;
+        }
+    }
+}
+
+template <detail::SerializableObject O> void Serializable::expose(const std::string& name, O*& value) {
+    // Abort if previous error was detected
+    if(result != Result::OK) return;
+
+    // Abort if value is a nullptr
+    if(value == nullptr) {
+        result = Result::POINTER;
+        return;
+    }
+
+    // Get address from value
+    void** address = std::bit_cast<void**>(&value);
+
+    if(mode == Mode::FINGERPRINTING) {
+        // Feed the target once all objects are numbered
+        hashing->hasher.updateValue(detail::fingerprint::POINTER);
+        hashing->hasher.updateString(name);
+        hashing->hasher.updateValue(value->classID());
+        hashing->targets.push_back(std::bit_cast<detail::Address>(value));
+    } else if(mode == Mode::SERIALIZING) {
+        // Append new serial pointer to root
+        serial->asObject()->append(std::make_unique<detail::SerialPointer>(value->classID(), name, address));
+    } else {
+        // Find serial value in root object
+        const auto serialValue = find(name);
+        if(!serialValue) {
+            result = Result::INTEGRITY;
+            return;
+        }
+
+        // Convert to serial pointer
+        auto* serialPointer = serialValue.value()->asPointer();
+        if(serialPointer == nullptr) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Check pointer type
+        if(serialPointer->getClass() != value->classID()) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Register location for address mapping
+        serialPointer->setTarget(address);
+    }
+}
+
+template <detail::SerializableContainer C>
+void Serializable::expose(const std::string& name, C& value, Encoding encoding) {
+    // Abort if previous error was detected
+    if(result != Result::OK) return;
+
+    // Create new serial container
+    detail::SerialContainer<C> serialContainer(value, encoding);
+
+    // Expose container
+    expose(name, serialContainer);
+}
+
+template <detail::SerializableContainer C>
+void Serializable::expose(const std::string& name, C& value, Quantization quantization) {
+    // Abort if previous error was detected
+    if(result != Result::OK) return;
+
+    // Create new serial container quantizing its elements
+    detail::SerialContainer<C> serialContainer(value, Encoding::PLAIN, quantization);
+
+    // Expose container
+    expose(name, serialContainer);
+}
+
+namespace detail {
+template <SerializableContainer C>
+SerialContainer<C>::SerialContainer(C& value, Encoding encoding, Quantization quantization)
+    : value(&value), encoding(encoding), quantization(quantization) {
+    container = true;
+}
+
+template <SerializableContainer C> void SerialContainer<C>::exposed() {
+    if constexpr(requires { value->begin()->first; }) {
+        // Generate list of keys (sorted for canonical data, as unordered maps iterate in the order of their buckets)
+        std::list<std::string> keys;
+        for(auto& [key, _] : *value) keys.push_back(key);
+        if constexpr(requires { value->bucket_count(); })
+            if(canonical && mode != Mode::DESERIALIZING) keys.sort();
+
+        // Expose keys
+        expose("keys", keys);
+
+        // Expose elements
+        for(const auto& key : keys) expose(key, (*value)[key]);
+
+        // Remove keys that are not in the container anymore
+        for(auto it = value->begin(); it != value->end();)
+            if(std::find(keys.begin(), keys.end(), it->first) == keys.end()) it = value->erase(it);
+            else it++;
+    } else if constexpr(Arithmetic<typename C::value_type>) {
+        // Fingerprint contiguous elements as a single block
+        if constexpr(std::ranges::contiguous_range<C>) {
+            if(mode == Mode::FINGERPRINTING) {
+                hashing->hasher.updateValue(static_cast<std::uint64_t>(value->size()));
+                hashing->hasher.update(std::string_view(std::bit_cast<const char*>(std::ranges::data(*value)),
+                                                        std::ranges::size(*value) * sizeof(typename C::value_type)));
+                return;
+            }
+        }
+
+        // Packed containers store all elements in a single "values" primitive (only in text, others use arrays)
+        const bool hinted = encoding != Encoding::PLAIN || quantization.type != Quantization::Type::NONE;
+        const bool packed = mode == Mode::SERIALIZING ? hinted && format == Options::Format::TEXT
+                          : mode == Mode::DESERIALIZING && serial->asObject()->getChild("values").has_value();
+        if(packed) exposePacked();
+        else exposeElements();
+    } else exposeElements();
+}
+
+template <SerializableContainer C> void SerialContainer<C>::exposeElements() {
+    // If container supports resize, expose size and resize container
+    if constexpr(requires { value->resize(0); }) {
+        // Expose size
+        std::size_t size = value->size();
+        expose("size", size);
+
+        // Resize container
+        if(size != value->size()) value->resize(size);
+    }
+
+    // Expose elements (quantizing floats if requested)
+    std::size_t index = 0;
+    for(auto& element : *value) {
+        if constexpr(std::floating_point<typename C::value_type>) {
+            if(quantization.type != Quantization::Type::NONE) {
+                expose(string::serializePrimitive(index++), element, quantization);
+                continue;
+            }
+        }
+        expose(string::serializePrimitive(index++), element);
+    }
+}
+
+template <SerializableContainer C> void SerialContainer<C>::exposePacked() {
+    const auto packings = SerialContainer<C>::packings();
+
+    if(mode == Mode::SERIALIZING) {
+        // Quantize floats if requested (packed as fixed point or half precision numbers)
+        if constexpr(std::floating_point<typename C::value_type>) {
+            if(quantization.type != Quantization::Type::NONE) {
+                if(!quantization.isValid()) {
+                    result = Result::TYPECHECK;
+                    return;
+                }
+                const std::vector<typename C::value_type> values(value->begin(), value->end());
+                const auto data = quantization.type == Quantization::Type::FIXED
+                                    ? packing::encodeFixed(std::span(values), quantization.scale, quantization.bits)
+                                    : packing::encodeHalf(std::span(values));
+                serial->asObject()->append(
+                  std::make_unique<SerialPrimitive>(quantizedType(quantization.type), "values", data));
+                return;
+            }
+        }
+
+        // Encode elements (trying every packing if the encoding is chosen automatically or not available for the type)
+        Encoding packing = encoding;
+        std::string data;
+        if(encoding == Encoding::AUTO || std::find(packings.begin(), packings.end(), encoding) == packings.end()) {
+            for(const Encoding candidate : packings) {
+                std::string candidateData = encode(candidate, *value);
+                if(data.empty() || candidateData.size() < data.size()) {
+                    packing = candidate;
+                    data    = std::move(candidateData);
+                }
+            }
+        } else data = encode(encoding, *value);
+
+        // Append packed values to root
+        serial->asObject()->append(std::make_unique<SerialPrimitive>(packedType(packing), "values", data));
+    } else {
+        // Convert to serial primitive
+        const auto* serialPrimitive = serial->asObject()->getChild("values").value()->asPrimitive();
+        if(serialPrimitive == nullptr) {
+            result = Result::TYPECHECK;
+            return;
+        }
+
+        // Decode packed values with the packing matching the primitive type (malformed values of a known type are
+        // a structure error, values of another type a type error)
+        std::optional<std::vector<typename C::value_type>> values;
+        bool typed = false;
+        for(const Encoding packing : packings) {
+            if(serialPrimitive->getType() != packedType(packing)) continue;
+            values = decode(packing, serialPrimitive->getValue());
+            typed  = true;
+        }
+        if constexpr(std::floating_point<typename C::value_type>) {
+            if(serialPrimitive->getType() == quantizedType(Quantization::Type::FIXED)) {
+                values = packing::decodeFixed<typename C::value_type>(serialPrimitive->getValue());
+                typed  = true;
+            }
+            if(serialPrimitive->getType() == quantizedType(Quantization::Type::HALF)) {
+                values = packing::decodeHalf<typename C::value_type>(serialPrimitive->getValue());
+                typed  = true;
+            }
+        }
+        if(!values) {
+            result = typed ? Result::STRUCTURE : Result::TYPECHECK;
+            return;
+        }
+
+        // Take decoded vectors as they are
+        if constexpr(std::is_same_v<C, std::vector<typename C::value_type>>) {
+            *value = std::move(values.value());
+            return;
+        }
+
+        // Resize container or check size
+        if constexpr(requires { value->resize(0); }) value->resize(values->size());
+        else if(values->size() != value->size()) {
+            result = Result::INTEGRITY;
+            return;
+        }
+
+        // Set values
+        std::copy(values->begin(), values->end(), value->begin());
+    }
+}
+
+template <SerializableContainer C> std::span<const Serializable::Encoding> SerialContainer<C>::packings() {
+    // Floats can only be packed by value, not by their differences
+    static const constexpr std::array integers = { Encoding::DELTA, Encoding::DELTA_OF_DELTA,
+                                                   Encoding::FRAME_OF_REFERENCE, Encoding::RUN_LENGTH,
+                                                   Encoding::SPARSE };
+    static const constexpr std::array floats   = { Encoding::RUN_LENGTH, Encoding::SPARSE };
+    if constexpr(Integer<typename C::value_type>) return integers;
+    else return floats;
+}
+
+// Pattern: ENCODING<TYPE>
+template <SerializableContainer C> std::string SerialContainer<C>::packedType(Encoding encoding) {
+    const std::string type = string::TypeToString<typename C::value_type>;
+    switch(encoding) {
+        case Encoding::DELTA: return string::makeString("DELTA<", type, ">");
+        case Encoding::DELTA_OF_DELTA: return string::makeString("DELTA_OF_DELTA<", type, ">");
+        case Encoding::FRAME_OF_REFERENCE: return string::makeString("FRAME_OF_REFERENCE<", type, ">");
+        case Encoding::RUN_LENGTH: return string::makeString("RUN_LENGTH<", type, ">");
+        case Encoding::SPARSE: return string::makeString("SPARSE<", type, ">");
+        default: return "";
+    }
+}
+
+// Pattern: QUANTIZATION<TYPE>
+template <SerializableContainer C> std::string SerialContainer<C>::quantizedType(Quantization::Type quantization) {
+    const std::string type = string::TypeToString<typename C::value_type>;
+    switch(quantization) {
+        case Quantization::Type::FIXED: return string::makeString("FIXED<", type, ">");
+        case Quantization::Type::HALF: return string::makeString("HALF<", type, ">");
+        default: return "";
+    }
+}
+
+template <SerializableContainer C> std::string SerialContainer<C>::encode(Encoding encoding, const C& values) {
+    if constexpr(Integer<typename C::value_type>) {
+        switch(encoding) {
+            case Encoding::DELTA: return packing::encodeDelta(values);
+            case Encoding::DELTA_OF_DELTA: return packing::encodeDeltaOfDelta(values);
+            case Encoding::FRAME_OF_REFERENCE: return packing::encodeFrameOfReference(values);
+            default: break;
+        }
+    }
+    switch(encoding) {
+        case Encoding::RUN_LENGTH: return packing::encodeRunLength(values);
+        case Encoding::SPARSE: return packing::encodeSparse(values);
+        default: return "";
+    }
+}
+
+template <SerializableContainer C>
+std::optional<std::vector<typename C::value_type>> SerialContainer<C>::decode(Encoding encoding,
+                                                                              const std::string& data) {
+    using T = typename C::value_type;
+
+    // Fixed size containers take no more elements than they hold
+    std::size_t maximum = packing::MAX_ELEMENTS;
+    if constexpr(requires { std::tuple_size<C>::value; }) maximum = std::tuple_size_v<C>;
+
+    if constexpr(Integer<T>) {
+        switch(encoding) {
+            case Encoding::DELTA: return packing::decodeDelta<T>(data);
+            case Encoding::DELTA_OF_DELTA: return packing::decodeDeltaOfDelta<T>(data);
+            case Encoding::FRAME_OF_REFERENCE: return packing::decodeFrameOfReference<T>(data);
+            default: break;
+        }
+    }
+    switch(encoding) {
+        case Encoding::RUN_LENGTH: return packing::decodeRunLength<T>(data, maximum);
+        case Encoding::SPARSE: return packing::decodeSparse<T>(data, maximum);
+        default: return std::nullopt;
+    }
+}
+
+inline std::map<unsigned char, std::shared_ptr<const Codec>>& codecs() {
+    // Register built-in codecs on first use
+    static std::map<unsigned char, std::shared_ptr<const Codec>> codecs = [] {
+        std::map<unsigned char, std::shared_ptr<const Codec>> builtin;
+        const auto add = [&builtin](std::shared_ptr<const Codec> codec) { builtin[codec->id()] = std::move(codec); };
+        add(std::make_shared<LZCodec>());
+#if defined(SERIALIZABLE_ZLIB)
+        add(std::make_shared<ZlibCodec>());
+#endif
+#if defined(SERIALIZABLE_ZSTD)
+        add(std::make_shared<ZstdCodec>());
+#endif
+        return builtin;
+    }();
+
+    return codecs;
+}
+
+inline std::mutex& codecsMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::shared_ptr<const Codec> findCodec(unsigned char id) {
+    const std::scoped_lock lock(codecsMutex());
+    const auto codec = codecs().find(id);
+    return codec == codecs().end() ? nullptr : codec->second;
+}
+
+inline void parallelFor(std::size_t count, unsigned int threads, const std::function<void(std::size_t)>& task) {
+    // Determine number of workers
+    if(threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t workers = std::min<std::size_t>(threads, count);
+
+    // Run on the calling thread if there is nothing to share
+    if(workers <= 1) {
+        for(std::size_t i = 0; i < count; i++) task(i);
+        return;
+    }
+
+    // Let workers take indices until all are done
+    std::atomic<std::size_t> next = 0;
+    std::vector<std::jthread> pool;
+    pool.reserve(workers);
+    for(std::size_t i = 0; i < workers; i++)
+        pool.emplace_back([&] {
+            for(std::size_t index = next++; index < count; index = next++) task(index);
+        });
+}
+
+namespace frame {
+inline void writeInteger(std::ostream& stream, std::uint32_t value) {
+    // Write little endian bytes
+    for(std::size_t i = 0; i < sizeof(value); i++) stream.put(static_cast<char>(value >> (8 * i) & 0xFF));
+}
+
+inline std::optional<std::uint32_t> readInteger(std::istream& stream) {
+    // Read little endian bytes
+    std::array<char, sizeof(std::uint32_t)> bytes{};
+    if(!stream.read(bytes.data(), bytes.size())) return std::nullopt;
+
+    std::uint32_t value = 0;
+    for(std::size_t i = 0; i < bytes.size(); i++)
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    return value;
+}
+
+// Pattern: MAGIC VERSION FORMAT FLAGS
+inline std::string makeHeader(Options::Format format, unsigned char flags) {
+    std::string header(MAGIC);
+    header.push_back(static_cast<char>(VERSION));
+    header.push_back(static_cast<char>(format));
+    header.push_back(static_cast<char>(flags));
+    return header;
+}
+
+inline bool hasHeader(Options::Format format) {
+    // Text, JSON and MessagePack can be told apart by their first byte
+    return format != Options::Format::TEXT && format != Options::Format::JSON && format != Options::Format::MSGPACK;
+}
+
+inline Options::Format detectFormat(std::string_view data) {
+    // MessagePack starts with a map or an array (text and JSON never start with a byte above 0x7F)
+    if(!data.empty()) {
+        const auto first = static_cast<unsigned char>(data[0]);
+        if((first >= 0x80 && first <= 0x9F) || (first >= 0xDC && first <= 0xDF)) return Options::Format::MSGPACK;
+    }
+
+    const std::size_t start = data.find_first_not_of(" \t\r\n");
+    return start != std::string_view::npos && data[start] == '{' ? Options::Format::JSON : Options::Format::TEXT;
+}
+
+inline bool detect(std::istream& stream) {
+    // Read potential magic bytes
+    std::array<char, MAGIC.size()> magic{};
+    stream.read(magic.data(), magic.size());
+    if(stream && std::string_view(magic.data(), magic.size()) == MAGIC) return true;
+
+    // Rewind if the stream is not a frame
+    stream.clear();
+    stream.seekg(0);
+    return false;
+}
+
+inline std::uint32_t checksum(Options::Checksum checksum, std::string_view data) {
+    switch(checksum) {
+        case Options::Checksum::CRC32C: return checksum::crc32c(data);
+        case Options::Checksum::XXHASH32: return checksum::xxhash32(data);
+        default: return 0;
+    }
+}
+
+inline std::optional<Header> readHeader(std::istream& stream) {
+    // Read header bytes (after the magic bytes)
+    std::array<char, 3> bytes{};
+    if(!stream.read(bytes.data(), bytes.size())) return std::nullopt;
+    const Header header{ static_cast<unsigned char>(bytes[0]), static_cast<Options::Format>(bytes[1]),
+                         static_cast<unsigned char>(bytes[2]) };
+
+    // Validate header (newer versions, unknown formats or unknown flags can not be read)
+    if(header.version == 0 || header.version > VERSION) return std::nullopt;
+    if(header.format > Options::Format::MSGPACK) return std::nullopt;
+    if((header.flags & ~BLOCKS) != 0) return std::nullopt;
+
+    return header;
+}
+
+inline bool writeData(std::ostream& stream, std::string_view data, const Options& options) {
+    // Write header and data (in blocks if they are compressed or checksummed)
+    if(options.codec || options.checksum != Options::Checksum::NONE) {
+        stream << makeHeader(options.format, BLOCKS);
+        return writeBlocks(stream, data, options);
+    }
+    if(hasHeader(options.format)) stream << makeHeader(options.format, 0);
+    return static_cast<bool>(stream.write(data.data(), static_cast<std::streamsize>(data.size())));
+}
+
+inline SavedFiles& savedFiles() {
+    static SavedFiles saved;
+    return saved;
+}
+
+inline std::uint64_t fingerprintData(std::string_view data, const Options& options) {
+    // Hash the options changing the framing before the data (blocks are compressed and checksummed by them)
+    fingerprint::Hasher hasher;
+    hasher.updateValue(options.format);
+    hasher.updateValue(options.codec ? options.codec->id() : static_cast<unsigned char>(0));
+    hasher.updateValue(options.checksum);
+    hasher.updateValue(options.blockSize);
+    hasher.update(data);
+    return hasher.digest();
+}
+
+inline std::optional<bool> isSaved(const std::filesystem::path& path, std::uint64_t fingerprint) {
+    // Missing files don't hold the data
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    if(error) return false;
+    const auto time = std::filesystem::last_write_time(path, error);
+    if(error) return false;
+
+    // Compare with the fingerprint saved last (unknown if the file was not saved by this process or modified since)
+    const std::string key = std::filesystem::absolute(path, error).lexically_normal().string();
+    SavedFiles& saved     = savedFiles();
+    const std::scoped_lock lock(saved.mutex);
+    const auto entry = saved.files.find(key);
+    if(entry == saved.files.end() || entry->second.size != size || entry->second.time != time) return std::nullopt;
+    return entry->second.fingerprint == fingerprint;
+}
+
+inline bool holdsFile(const std::filesystem::path& path, std::string_view file) {
+    // Only read files of the same size
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    if(error || size != file.size()) return false;
+    const auto stored = file::readFile(path);
+    return stored && stored.value() == file;
+}
+
+inline void setSaved(const std::filesystem::path& path, std::uint64_t fingerprint) {
+    std::error_code error;
+    const std::string key     = std::filesystem::absolute(path, error).lexically_normal().string();
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    if(error) return;
+    const auto time = std::filesystem::last_write_time(path, error);
+    if(error) return;
+
+    SavedFiles& saved = savedFiles();
+    const std::scoped_lock lock(saved.mutex);
+    saved.files[key] = { fingerprint, size, time };
+}
+
+inline bool readSized(std::istream& stream, std::string& data, std::size_t size) {
+    // Read in chunks, so a corrupt size fails at the end of the stream instead of allocating all of it up front
+    static const constexpr std::size_t CHUNK_SIZE = 1 << 20;
+    data.clear();
+    while(data.size() < size) {
+        const std::size_t offset = data.size();
+        data.resize(offset + std::min(CHUNK_SIZE, size - offset));
+        if(!stream.read(data.data() + offset, static_cast<std::streamsize>(data.size() - offset))) // NOLINT
+            return false;
+    }
+    return true;
+}
+
+// Pattern: CODEC CHECKSUM {RAW_SIZE STORED_SIZE [BLOCK_CHECKSUM] BLOCK} 0 0 (equal sizes: uncompressed block)
+inline bool writeBlocks(std::ostream& stream, std::string_view data, const Options& options) {
+    BlockWriter writer(stream, options);
+    writer.write(data);
+    return writer.finish();
+}
+
+inline BlockWriter::BlockWriter(std::ostream& stream, const Options& options)
+    : stream(stream), options(options), blockSize(std::clamp<std::size_t>(options.blockSize, 1, UINT32_MAX)),
+      threads(options.threads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : options.threads),
+      blocks(threads), checksums(threads) {
+    // Write block header (codec 0 stores blocks uncompressed)
+    stream.put(static_cast<char>(options.codec ? options.codec->id() : 0));
+    stream.put(static_cast<char>(options.checksum));
+}
+
+inline void BlockWriter::write(std::string_view data) {
+    const std::size_t batchSize = blockSize * threads;
+
+    // Complete pending batch
+    if(!pending.empty()) {
+        const std::size_t missing = std::min(batchSize - pending.size(), data.size());
+        pending.append(data.substr(0, missing));
+        data.remove_prefix(missing);
+        if(pending.size() < batchSize) return;
+        writeBatch(pending);
+        pending.clear();
+    }
+
+    // Write full batches without copying them, keep the rest pending
+    for(; data.size() >= batchSize; data.remove_prefix(batchSize)) writeBatch(data.substr(0, batchSize));
+    pending.assign(data);
+}
+
+inline bool BlockWriter::finish() {
+    // Write pending (partial) batch
+    writeBatch(pending);
+    pending.clear();
+
+    // Write end marker
+    writeInteger(stream, 0);
+    writeInteger(stream, 0);
+
+    return stream.good();
+}
+
+inline void BlockWriter::writeBatch(std::string_view batch) {
+    // Compress and checksum blocks in parallel
+    const std::size_t count = (batch.size() + blockSize - 1) / blockSize;
+    parallelFor(count, threads, [&](std::size_t i) {
+        const std::string_view raw = batch.substr(i * blockSize, blockSize);
+        blocks[i]                  = options.codec ? options.codec->compress(raw) : "";
+        checksums[i]               = checksum(options.checksum, raw);
+    });
+
+    // Write blocks in order
+    for(std::size_t i = 0; i < count; i++) {
+        const std::string_view raw = batch.substr(i * blockSize, blockSize);
+        const bool stored          = blocks[i].empty() || blocks[i].size() >= raw.size();
+        writeInteger(stream, raw.size());
+        writeInteger(stream, stored ? raw.size() : blocks[i].size());
+        if(options.checksum != Options::Checksum::NONE) writeInteger(stream, checksums[i]);
+        if(stored) stream.write(raw.data(), static_cast<std::streamsize>(raw.size()));
+        else stream.write(blocks[i].data(), static_cast<std::streamsize>(blocks[i].size()));
+    }
+}
+
+inline std::pair<Serializable::Result, std::string> readBlocks(std::istream& stream, unsigned int threads) {
+    // Collect all blocks
+    std::string data;
+    const auto result = readBlocks(stream, [&](std::string_view block) { data.append(block); }, threads);
+    if(result != Serializable::Result::OK) return { result, "" };
+    return { result, std::move(data) };
+}
+
+inline Serializable::Result readBlocks(std::istream& stream, const std::function<void(std::string_view)>& consume,
+                                       unsigned int threads) {
+    using Result = Serializable::Result;
+    if(threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+
+    // Find codec (codec 0 stores blocks uncompressed)
+    const int id = stream.get();
+    if(id == std::char_traits<char>::eof()) return Result::STRUCTURE;
+    const auto codec = id == 0 ? nullptr : findCodec(static_cast<unsigned char>(id));
+    if(id != 0 && !codec) return Result::STRUCTURE;
+
+    // Find checksum
+    const int checksumID = stream.get();
+    if(checksumID < 0 || checksumID > static_cast<int>(Options::Checksum::XXHASH32)) return Result::STRUCTURE;
+    const auto checksumType = static_cast<Options::Checksum>(checksumID);
+
+    // Read one batch of blocks per thread at a time, decompress and verify them in parallel
+    std::vector<std::tuple<std::uint32_t, std::uint32_t, std::string>> blocks(threads);
+    std::vector<std::pair<Result, std::string>> decompressed(threads);
+    bool end = false;
+    while(!end) {
+        // Read blocks until the batch is full or the end marker is reached
+        std::size_t batchSize = 0;
+        while(batchSize < threads) {
+            const auto rawSize    = readInteger(stream);
+            const auto storedSize = readInteger(stream);
+            if(!rawSize || !storedSize) return Result::STRUCTURE;
+            if(*rawSize == 0 && *storedSize == 0) {
+                end = true;
+                break;
+            }
+
+            auto& [size, blockChecksum, block] = blocks[batchSize++];
+            size                               = *rawSize;
+            if(checksumType != Options::Checksum::NONE) {
+                const auto storedChecksum = readInteger(stream);
+                if(!storedChecksum) return Result::STRUCTURE;
+                blockChecksum = *storedChecksum;
+            }
+
+            if(!readSized(stream, block, *storedSize)) return Result::STRUCTURE;
+        }
+
+        // Decompress and verify blocks
+        parallelFor(batchSize, threads, [&](std::size_t i) {
+            const auto& [size, blockChecksum, block] = blocks[i];
+            std::optional<std::string> raw;
+            if(block.size() == size) raw = block;
+            else if(codec) raw = codec->decompress(block, size);
+
+            if(!raw) decompressed[i] = { Result::STRUCTURE, "" };
+            else if(checksum(checksumType, raw.value()) != blockChecksum) decompressed[i] = { Result::CHECKSUM, "" };
+            else decompressed[i] = { Result::OK, std::move(raw.value()) };
+        });
+
+        // Pass blocks on in order
+        for(std::size_t i = 0; i < batchSize; i++) {
+            if(decompressed[i].first != Result::OK) return decompressed[i].first;
+            consume(decompressed[i].second);
+        }
+    }
+
+    return Result::OK;
+}
+} // namespace frame
+
+namespace temporal {
+inline void BitWriter::write(packing::Word value, unsigned int bits) {
+    // Fill the last byte before starting a new one
+    while(bits > 0) {
+        if(used == 0) data.push_back(0);
+        const unsigned int take = std::min(bits, 8 - used);
+        const auto chunk        = static_cast<unsigned int>(value >> (bits - take)) & ((1U << take) - 1);
+        const auto byte         = static_cast<unsigned char>(data.back());
+        data.back()             = static_cast<char>(byte | chunk << (8 - used - take));
+        used                    = (used + take) % 8;
+        bits -= take;
+    }
+}
+
+inline std::string BitWriter::finish() {
+    used = 0;
+    return std::move(data);
+}
+
+inline BitReader::BitReader(std::string_view data) : data(data) {}
+
+inline std::optional<packing::Word> BitReader::read(unsigned int bits) {
+    // Check remaining bits
+    if(bits > data.size() * 8 - pos) return std::nullopt;
+
+    // Read the rest of the current byte before starting the next one
+    packing::Word value = 0;
+    while(bits > 0) {
+        const auto used         = static_cast<unsigned int>(pos % 8);
+        const unsigned int take = std::min(bits, 8 - used);
+        const auto byte         = static_cast<unsigned char>(data[pos / 8]);
+        value                   = value << take | ((byte >> (8 - used - take)) & ((1U << take) - 1));
+        pos += take;
+        bits -= take;
+    }
+
+    return value;
+}
+
+inline bool BitReader::finished() const { return data.size() * 8 - pos < 8; }
+
+inline Field makeField(const std::string& type, const std::string& value) {
+    // Find kind by type (numbers that can't be parsed are stored as they are)
+    Field field;
+    if(type == string::TypeToString<float>) field.kind = Kind::FLOAT;
+    else if(type == string::TypeToString<double>) field.kind = Kind::DOUBLE;
+    else if(type == string::TypeToString<char> || type == string::TypeToString<short> ||
+            type == string::TypeToString<int> || type == string::TypeToString<long>)
+        field.kind = Kind::SIGNED;
+    else if(type == string::TypeToString<unsigned char> || type == string::TypeToString<unsigned short> ||
+            type == string::TypeToString<unsigned int> || type == string::TypeToString<unsigned long> ||
+            type == "ENUM")
+        field.kind = Kind::UNSIGNED;
+    else field.kind = Kind::RAW;
+
+    // Take value
+    const auto bits = field.kind == Kind::RAW ? std::nullopt : parseBits(field.kind, value);
+    if(bits) field.value = bits.value();
+    else {
+        field.kind = Kind::RAW;
+        field.text = value;
+    }
+
+    return field;
+}
+
+inline std::optional<packing::Word> parseBits(Kind kind, const std::string& value) {
+    const auto parse = [&value]<typename T>(T& number) {
+        std::from_chars_result parsed;
+        if constexpr(std::floating_point<T>) parsed = packing::parseFloat(value, number);
+        else parsed = packing::parseInteger(value, number);
+        return parsed.ec == std::errc() && parsed.ptr == value.data() + value.size(); // NOLINT(*-pointer-arithmetic)
+    };
+    switch(kind) {
+        case Kind::SIGNED: {
+            std::int64_t number = 0;
+            if(parse(number)) return static_cast<packing::Word>(number);
+            break;
+        }
+        case Kind::UNSIGNED: {
+            std::uint64_t number = 0;
+            if(parse(number)) return number;
+            break;
+        }
+        case Kind::FLOAT: {
+            float number = 0;
+            if(parse(number)) return std::bit_cast<std::uint32_t>(number);
+            break;
+        }
+        case Kind::DOUBLE: {
+            double number = 0;
+            if(parse(number)) return std::bit_cast<std::uint64_t>(number);
+            break;
+        }
+        default: break;
+    }
+    return std::nullopt;
+}
+
+inline std::string formatBits(Kind kind, packing::Word bits) {
+    switch(kind) {
+        case Kind::SIGNED: return string::serializePrimitive(static_cast<long>(bits));
+        case Kind::UNSIGNED: return string::serializePrimitive(static_cast<unsigned long>(bits));
+        case Kind::FLOAT: return string::serializePrimitive(std::bit_cast<float>(static_cast<std::uint32_t>(bits)));
+        case Kind::DOUBLE: return string::serializePrimitive(std::bit_cast<double>(bits));
+        default: return "";
+    }
+}
+
+// Integers: 0 (unchanged delta), 10 + 7 bits, 110 + 9 bits, 1110 + 12 bits or 1111 + 64 bits of the zigzag encoded
+// delta of delta. Floats: 0 (unchanged), 10 + bits inside the previous window or 11 + 5 bits leading zeros + 6 bits
+// length - 1 + meaningful bits of the XOR. Others: 0 (unchanged) or 1 + 32 bits length + bytes.
+inline bool encodeField(BitWriter& writer, Field& field, const std::string& value) {
+    // Write other primitives if they changed
+    if(field.kind == Kind::RAW) {
+        if(value == field.text) writer.write(0, 1);
+        else {
+            writer.write(1, 1);
+            writer.write(value.size(), 32);
+            for(const char c : value) writer.write(static_cast<unsigned char>(c), 8);
+            field.text = value;
+        }
+        return true;
+    }
+
+    // Parse number (failing numbers need a keyframe)
+    const auto bits = parseBits(field.kind, value);
+    if(!bits) return false;
+
+    if(field.kind == Kind::SIGNED || field.kind == Kind::UNSIGNED) {
+        // Write zigzag encoded delta of delta into the smallest bucket
+        const packing::Word delta = bits.value() - field.value;
+        const packing::Word dod   = delta - field.delta;
+        const packing::Word zig   = dod << 1 ^ static_cast<packing::Word>(static_cast<std::int64_t>(dod) >> 63);
+        if(zig == 0) writer.write(0, 1);
+        else if(zig < 1 << 7) writer.write(0b10 << 7 | zig, 9);
+        else if(zig < 1 << 9) writer.write(0b110 << 9 | zig, 12);
+        else if(zig < 1 << 12) writer.write(0b1110 << 12 | zig, 16);
+        else {
+            writer.write(0b1111, 4);
+            writer.write(zig, 64);
+        }
+        field.value = bits.value();
+        field.delta = delta;
+        return true;
+    }
+
+    // Write XOR with the previous float (reusing the previous window of meaningful bits if it fits)
+    const unsigned int width    = field.kind == Kind::FLOAT ? 32 : 64;
+    const packing::Word changes = bits.value() ^ field.value;
+    field.value                 = bits.value();
+    if(changes == 0) {
+        writer.write(0, 1);
+        return true;
+    }
+    const auto leading  = std::min(static_cast<unsigned int>(std::countl_zero(changes)) - (64 - width), 31U);
+    const auto trailing = static_cast<unsigned int>(std::countr_zero(changes));
+    if(field.window && leading >= field.leading && trailing >= field.trailing) {
+        writer.write(0b10, 2);
+        writer.write(changes >> field.trailing, width - field.leading - field.trailing);
+        return true;
+    }
+    writer.write(0b11, 2);
+    writer.write(leading, 5);
+    writer.write(width - leading - trailing - 1, 6);
+    writer.write(changes >> trailing, width - leading - trailing);
+    field.leading  = leading;
+    field.trailing = trailing;
+    field.window   = true;
+    return true;
+}
+
+inline std::optional<std::string> decodeField(BitReader& reader, Field& field) {
+    const auto changed = reader.read(1);
+    if(!changed) return std::nullopt;
+
+    // Read other primitives if they changed
+    if(field.kind == Kind::RAW) {
+        if(changed.value() == 0) return field.text;
+        const auto size = reader.read(32);
+        if(!size) return std::nullopt;
+        std::string text; // Not reserved, the size is only trusted as far as there are bits for it
+        for(std::size_t i = 0; i < size.value(); i++) {
+            const auto c = reader.read(8);
+            if(!c) return std::nullopt;
+            text.push_back(static_cast<char>(c.value()));
+        }
+        field.text = text;
+        return text;
+    }
+
+    if(field.kind == Kind::SIGNED || field.kind == Kind::UNSIGNED) {
+        // Find bucket by the number of leading ones and read zigzag encoded delta of delta
+        packing::Word zig = 0;
+        if(changed.value() == 1) {
+            unsigned int ones = 1;
+            for(; ones < 4; ones++) {
+                const auto bit = reader.read(1);
+                if(!bit) return std::nullopt;
+                if(bit.value() == 0) break;
+            }
+            const auto read = reader.read(std::array{ 7U, 9U, 12U, 64U }.at(ones - 1));
+            if(!read) return std::nullopt;
+            zig = read.value();
+        }
+        const packing::Word dod = zig >> 1 ^ (0 - (zig & 1));
+        field.delta += dod;
+        field.value += field.delta;
+        return formatBits(field.kind, field.value);
+    }
+
+    // Read XOR with the previous float (in the previous window or a new one)
+    const unsigned int width = field.kind == Kind::FLOAT ? 32 : 64;
+    if(changed.value() == 1) {
+        const auto reuse = reader.read(1);
+        if(!reuse) return std::nullopt;
+        if(reuse.value() == 1) {
+            const auto leading = reader.read(5), length = reader.read(6);
+            if(!leading || !length || leading.value() + length.value() + 1 > width) return std::nullopt;
+            field.leading  = static_cast<unsigned int>(leading.value());
+            field.trailing = width - field.leading - static_cast<unsigned int>(length.value()) - 1;
+            field.window   = true;
+        } else if(!field.window) return std::nullopt;
+        const auto value = reader.read(width - field.leading - field.trailing);
+        if(!value) return std::nullopt;
+        field.value ^= value.value() << field.trailing;
+    }
+    return formatBits(field.kind, field.value);
+}
+} // namespace temporal
+} // namespace detail
+
+inline TemporalEncoder::TemporalEncoder(Serializable& object, std::size_t keyframeInterval)
+    : object(&object), keyframeInterval(keyframeInterval) {}
+
+inline std::pair<Serializable::Result, std::string> TemporalEncoder::encode() {
+    // Collect serial objects
+    const Serializable::Result collected = object->collect({});
+    if(collected != Serializable::Result::OK) return { collected, "" };
+
+    // Outline snapshot
+    std::string outline;
+    std::vector<detail::SerialPrimitive*> primitives;
+    object->serial->asObject()->outline(outline, primitives);
+
+    // Write delta frame if the structure did not change and no keyframe is due
+    const bool due = keyframeInterval != 0 && frames >= keyframeInterval;
+    if(structure == outline && !due) {
+        detail::temporal::BitWriter writer;
+        bool encoded = true;
+        for(std::size_t i = 0; i < primitives.size() && encoded; i++)
+            encoded = detail::temporal::encodeField(writer, fields[i], primitives[i]->getValue());
+        if(encoded) {
+            frames++;
+            return { Serializable::Result::OK, detail::temporal::DELTA + writer.finish() };
+        }
+    }
+
+    // Write keyframe and start over from its values
+    fields.clear();
+    fields.reserve(primitives.size());
+    for(const auto* primitive : primitives)
+        fields.push_back(detail::temporal::makeField(primitive->getType(), primitive->getValue()));
+    structure = std::move(outline);
+    frames    = 1;
+    return { Serializable::Result::OK, detail::string::makeString(std::string(1, detail::temporal::KEYFRAME),
+                                                                  std::string(detail::string::VERSION), "\n",
+                                                                  object->serial->get()) };
+}
+
+inline TemporalDecoder::TemporalDecoder(Serializable& object) : object(&object) {}
+
+inline Serializable::Result TemporalDecoder::decode(std::string_view frame) {
+    if(frame.starts_with(detail::temporal::KEYFRAME)) {
+        // Parse keyframe and keep it to apply the following frames to
+        previous.reset();
+        const Serializable::Result parsed = object->parse(Options::Format::TEXT, frame.substr(1));
+        if(parsed != Serializable::Result::OK) return parsed;
+        previous = object->serial->clone();
+
+        // Start over from its values
+        std::string outline;
+        primitives.clear();
+        previous->asObject()->outline(outline, primitives);
+        fields.clear();
+        fields.reserve(primitives.size());
+        for(const auto* primitive : primitives)
+            fields.push_back(detail::temporal::makeField(primitive->getType(), primitive->getValue()));
+        return object->decodeSerial();
+    }
+
+    // Delta frames need the previous snapshot
+    if(!frame.starts_with(detail::temporal::DELTA) || !previous) return Serializable::Result::STRUCTURE;
+
+    // Apply changes to the previous snapshot (a broken frame breaks every frame until the next keyframe)
+    detail::temporal::BitReader reader(frame.substr(1));
+    for(std::size_t i = 0; i < primitives.size(); i++) {
+        auto value = detail::temporal::decodeField(reader, fields[i]);
+        if(!value) {
+            previous.reset();
+            return Serializable::Result::STRUCTURE;
+        }
+        primitives[i]->setValue(std::move(value.value()));
+    }
+    if(!reader.finished()) {
+        previous.reset();
+        return Serializable::Result::STRUCTURE;
+    }
+
+    // Restore snapshot
+    return object->restore(previous->clone());
+}
+
+namespace detail::fingerprint {
+inline void Hasher::update(std::string_view data) {
+    // Collect small pieces into a block, hash large pieces directly
+    if(buffer.size() + data.size() <= BLOCK_SIZE) {
+        buffer.append(data);
+        return;
+    }
+    flush();
+    if(data.size() >= BLOCK_SIZE) hash = checksum::xxhash64(data, hash);
+    else buffer.append(data);
+}
+
+inline void Hasher::updateString(std::string_view str) {
+    // Prefix strings with their size, so neighbouring strings can not be shifted into each other
+    updateValue(static_cast<std::uint64_t>(str.size()));
+    update(str);
+}
+
+template <typename T> void Hasher::updateValue(const T& value) {
+    const auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+    update(std::string_view(bytes.data(), bytes.size()));
+}
+
+inline std::uint64_t Hasher::digest() {
+    flush();
+    return hash;
+}
+
+inline void Hasher::flush() {
+    if(buffer.empty()) return;
+    hash = checksum::xxhash64(buffer, hash);
+    buffer.clear();
+}
+} // namespace detail::fingerprint
+
+namespace detail::file {
+inline bool writeFile(const std::filesystem::path& path, std::string_view data) {
+    // Write to a temporary file first and move it into place, so a file is never seen partially written
+    const std::filesystem::path temporary = path.string() + ".tmp";
+    std::ofstream stream(temporary, std::ios::binary);
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+    stream.close();
+
+    std::error_code error;
+    if(stream) std::filesystem::rename(temporary, path, error);
+    if(!stream || error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+inline std::optional<std::string> readFile(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if(!stream) return std::nullopt;
+    std::stringstream str;
+    str << stream.rdbuf();
+    return str.str();
+}
+} // namespace detail::file
+
+namespace detail::store {
+inline std::string hashName(std::uint64_t hash) {
+    // Write 16 hexadecimal digits
+    std::string name(16, '0');
+    for(auto it = name.rbegin(); it != name.rend(); it++, hash >>= 4) *it = "0123456789abcdef"[hash & 0xF];
+    return name;
+}
+
+inline bool isFileName(std::string_view name) {
+    // Names must stay inside their directory (no separators, no parent directories)
+    return !name.empty() && name != "." && name.find("..") == std::string_view::npos &&
+           name.find_first_of("/\\") == std::string_view::npos;
+}
+
+} // namespace detail::store
+
+inline IncrementalSerializer::IncrementalSerializer(Serializable& object, Options options)
+    : object(&object), options(std::move(options)) {}
+
+inline bool IncrementalSerializer::step(std::size_t nodes) {
+    std::size_t written = 0;
+    return run([&written, nodes] { return ++written >= nodes; });
+}
+
+inline bool IncrementalSerializer::step(std::chrono::steady_clock::duration time) {
+    const auto deadline = std::chrono::steady_clock::now() + time;
+    return run([deadline] { return std::chrono::steady_clock::now() >= deadline; });
+}
+
+inline bool IncrementalSerializer::finished() const { return done; }
+
+inline std::pair<Serializable::Result, std::string> IncrementalSerializer::finish() {
+    // Write what is left in a single step
+    static_cast<void>(run([] { return false; }));
+    return { result, std::move(data) };
+}
+
+inline bool IncrementalSerializer::run(const std::function<bool()>& exhausted) {
+    if(done) return true;
+
+    // Only run the exposers and write everything before the root object in the first step (other formats completely)
+    if(!started) {
+        started = true;
+        if(options.format != Options::Format::TEXT) {
+            std::tie(result, data) = object->encode(options);
+            done                   = true;
+            return true;
+        }
+        result = object->collect(options);
+        if(result != Serializable::Result::OK) {
+            done = true;
+            return true;
+        }
+        data = object->prepareText(options);
+        root = std::move(object->serial);
+        stack.push_back({ { root.get() } });
+        return false;
+    }
+
+    // Write one node after another (at least one per step), like Serial::get would
+    const auto indentation = [this](std::size_t depth) { return std::string(options.compact ? 0 : depth, '\t'); };
+    do {
+        Frame& frame = stack.back();
+        if(frame.next == frame.children.size()) {
+            // Close the object (the first frame closes the text)
+            stack.pop_back();
+            if(stack.empty()) {
+                done = true;
+                return true;
+            }
+            data.append("\n").append(indentation(stack.size() - 1)).append("}");
+            continue;
+        }
+
+        // Write primitives, pointers and inline objects on their line
+        const detail::Serial* child = frame.children[frame.next++];
+        const std::size_t depth     = stack.size() - 1;
+        if(frame.next > 1) data.push_back('\n');
+        data.append(indentation(depth));
+        const auto* nested = dynamic_cast<const detail::SerialObject*>(child);
+        if(nested == nullptr) {
+            data.append(child->get(options.compact));
+            continue;
+        }
+        if(options.inlining) {
+            const auto line = nested->getInline(options.compact);
+            if(line) {
+                data.append(line.value());
+                continue;
+            }
+        }
+
+        // Open other objects (empty objects get an empty line)
+        data.append(nested->getHeader(options.compact)).append(options.compact ? "{\n" : " {\n");
+        auto children = nested->getChildren();
+        if(children.empty()) data.append(indentation(depth + 1));
+        stack.push_back({ std::move(children) });
+    } while(!exhausted());
+
+    return false;
+}
+
+inline SnapshotStore::SnapshotStore(std::filesystem::path directory) : directory(std::move(directory)) {}
+
+inline Serializable::Result SnapshotStore::save(Serializable& object, const std::string& name) const {
+    // Check name (snapshots are files in the store)
+    if(!detail::store::isFileName(name)) return Serializable::Result::FILE;
+
+    // Collect serial objects
+    const Serializable::Result collected = object.collect({});
+    if(collected != Serializable::Result::OK) return collected;
+
+    // Create directories
+    for(const auto* subdirectory : { "objects", "snapshots" }) {
+        std::error_code error;
+        std::filesystem::create_directories(directory / subdirectory, error);
+        if(error) return Serializable::Result::FILE;
+    }
+
+    // Store nested objects innermost first, replacing each by the hash of its content (existing ones are kept, as
+    // they are moved into place complete). The content has a fixed name and no address, so equal objects are stored
+    // once wherever they are, the manifest keeps the name and the address (if any) after the hash.
+    bool written = true;
+    std::function<std::unique_ptr<detail::Serial>(detail::Serial&)> store;
+    store = [&](detail::Serial& child) -> std::unique_ptr<detail::Serial> {
+        auto* nested = child.asObject();
+        if(nested == nullptr) return nullptr;
+        nested->replace(store);
+
+        const std::string childName = nested->getName();
+        const detail::Address address = nested->getVirtualAddress();
+        nested->emplace(nested->getClass(), detail::store::OBJECT, 0, 0);
+        const std::string data = nested->get();
+        const std::string hash = detail::store::hashName(detail::checksum::xxhash64(data));
+        const auto path        = directory / "objects" / hash;
+        if(!std::filesystem::exists(path)) written = detail::file::writeFile(path, data) && written;
+        const std::string value =
+          address == 0 ? hash : detail::string::makeString(hash, " ", detail::string::serializePrimitive(address));
+        return std::make_unique<detail::SerialPrimitive>(detail::store::SUBTREE, childName, value);
+    };
+    object.serial->asObject()->replace(store);
+
+    // Write manifest
+    const std::string manifest =
+      detail::string::makeString(std::string(detail::string::VERSION), "\n", object.serial->get());
+    if(!written || !detail::file::writeFile(directory / "snapshots" / name, manifest))
+        return Serializable::Result::FILE;
+    return Serializable::Result::OK;
+}
+
+inline Serializable::Result SnapshotStore::load(Serializable& object, const std::string& name) const {
+    // Read and parse manifest
+    if(!detail::store::isFileName(name)) return Serializable::Result::FILE;
+    const auto manifest = detail::file::readFile(directory / "snapshots" / name);
+    if(!manifest) return Serializable::Result::FILE;
+    const std::string header = detail::string::makeString(std::string(detail::string::VERSION), "\n");
+    if(!manifest->starts_with(header)) return Serializable::Result::STRUCTURE;
+    auto root = std::make_unique<detail::SerialObject>();
+    if(!root->set(manifest->substr(header.size()))) return Serializable::Result::STRUCTURE;
+
+    // Replace hashes by the stored objects (checking their content against the hash)
+    Serializable::Result result = Serializable::Result::OK;
+    std::function<std::unique_ptr<detail::Serial>(detail::Serial&)> resolve;
+    resolve = [&](detail::Serial& child) -> std::unique_ptr<detail::Serial> {
+        const auto* primitive = child.asPrimitive();
+        if(result != Serializable::Result::OK || primitive == nullptr || primitive->getType() != detail::store::SUBTREE)
+            return nullptr;
+
+        // Split hash and address (if any)
+        const std::string value = primitive->getValue();
+        const std::string hash  = value.substr(0, value.find(' '));
+        std::optional<detail::Address> address = 0;
+        if(hash.size() != value.size())
+            address = detail::string::deserializePrimitive<detail::Address>(value.substr(hash.size() + 1));
+        if(!address || !detail::store::isFileName(hash)) {
+            result = Serializable::Result::STRUCTURE;
+            return nullptr;
+        }
+
+        const auto data = detail::file::readFile(directory / "objects" / hash);
+        if(!data) result = Serializable::Result::FILE;
+        else if(detail::store::hashName(detail::checksum::xxhash64(data.value())) != hash)
+            result = Serializable::Result::CHECKSUM;
+        if(result != Serializable::Result::OK) return nullptr;
+
+        auto nested = std::make_unique<detail::SerialObject>();
+        if(!nested->set(data.value())) {
+            result = Serializable::Result::STRUCTURE;
+            return nullptr;
+        }
+        nested->emplace(nested->getClass(), primitive->getName(), 0, address.value());
+        nested->replace(resolve);
+        return nested;
+    };
+    root->replace(resolve);
+    if(result != Serializable::Result::OK) return result;
+
+    // Deserialize reassembled snapshot
+    return object.restore(std::move(root));
 }
-} // namespace detail
 } // namespace serializable
@@ -0,0 +1,548 @@
+#include "serializable.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Command line tool converting and inspecting save files.
+// Files are processed chunk by chunk (or block by block), so memory usage does not grow with the file size.
+
+using serializable::Options;
+using Result = serializable::Serializable::Result;
+
+const constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+const std::array<std::string_view, 8> RESULTS = { "OK", "FILE", "STRUCTURE", "INTEGRITY", "TYPECHECK", "POINTER",
+                                                  "CHECKSUM", "ENCODING" };
+
+// Reading
+Result readChunks(std::istream& stream, const std::function<void(std::string_view)>& consume) {
+    std::string chunk(CHUNK_SIZE, '\0');
+    while(stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || stream.gcount() > 0)
+        consume(std::string_view(chunk.data(), static_cast<std::size_t>(stream.gcount())));
+    return stream.bad() ? Result::FILE : Result::OK;
+}
+
+// Passes data on chunk by chunk, its format is set before the first chunk is passed on
+Result readData(std::istream& stream, unsigned int threads, Options::Format& format,
+                const std::function<void(std::string_view)>& consume) {
+    // Read headerless text, JSON or MessagePack (detected from the first chunk)
+    if(!serializable::detail::frame::detect(stream)) {
+        bool first = true;
+        return readChunks(stream, [&](std::string_view data) {
+            if(first) format = serializable::detail::frame::detectFormat(data);
+            first = false;
+            consume(data);
+        });
+    }
+
+    // Read header
+    const auto header = serializable::detail::frame::readHeader(stream);
+    if(!header) return Result::STRUCTURE;
+    format = header->format;
+
+    // Read data stored in blocks or remaining data
+    if((header->flags & serializable::detail::frame::BLOCKS) != 0)
+        return serializable::detail::frame::readBlocks(stream, consume, threads);
+    return readChunks(stream, consume);
+}
+
+// Lines
+class Lines {
+  public:
+    Lines()                        = default;
+    Lines(const Lines&)            = delete;
+    Lines(Lines&&)                 = delete;
+    Lines& operator=(const Lines&) = delete;
+    Lines& operator=(Lines&&)      = delete;
+    virtual ~Lines()               = default;
+
+    void consume(std::string_view data);
+    void flush();
+
+  protected:
+    virtual void line(std::string_view line, bool last) = 0;
+
+  private:
+    std::string partial;
+};
+
+void Lines::consume(std::string_view data) {
+    // Complete partial line
+    if(!partial.empty()) {
+        const std::size_t end = data.find('\n');
+        if(end == std::string_view::npos) {
+            partial.append(data);
+            return;
+        }
+
+        partial.append(data.substr(0, end));
+        line(partial, false);
+        partial.clear();
+        data.remove_prefix(end + 1);
+    }
+
+    // Process complete lines, keep the rest
+    for(std::size_t end = data.find('\n'); end != std::string_view::npos; end = data.find('\n')) {
+        line(data.substr(0, end), false);
+        data.remove_prefix(end + 1);
+    }
+    partial.assign(data);
+}
+
+void Lines::flush() {
+    // Process last line (files don't end with a newline)
+    if(!partial.empty()) line(partial, true);
+    partial.clear();
+}
+
+// Pattern: TYPE NAME = VALUE (compact: TYPE NAME=VALUE), Returns: (type, name, value)
+std::optional<std::array<std::string_view, 3>> parseLine(std::string_view line) {
+    const std::size_t space  = line.find(' ');
+    const std::size_t equals = line.find('=', space);
+    if(space == std::string_view::npos || equals == std::string_view::npos) return std::nullopt;
+
+    const bool pretty = equals + 1 < line.size() && line.at(equals + 1) == ' ';
+    return std::array{ line.substr(0, space), line.substr(space + 1, (pretty ? equals - 1 : equals) - space - 1),
+                       line.substr(pretty ? equals + 2 : equals + 1) };
+}
+
+// Pattern: ADDRESS { CHILD; CHILD } (compact: ADDRESS{CHILD;CHILD}), Returns: children of an inline object
+std::optional<std::vector<std::string_view>> parseInline(std::string_view value) {
+    const std::size_t opening = value.find('{');
+    if(opening == std::string_view::npos || opening == 0 || !value.ends_with('}')) return std::nullopt;
+
+    // Remove braces (and the spaces inside them if pretty), then split at semicolons
+    const std::size_t margin = value.at(opening - 1) == ' ' ? 2 : 1;
+    if(value.size() < opening + 2 * margin) return std::nullopt;
+    std::string_view children = value.substr(opening + margin, value.size() - opening - 2 * margin);
+    std::vector<std::string_view> result;
+    for(std::size_t end = children.find(';'); !children.empty(); end = children.find(';')) {
+        result.push_back(children.substr(0, end));
+        children.remove_prefix(end == std::string_view::npos ? children.size() : end + margin);
+    }
+    return result;
+}
+
+// Statistics
+class Statistics : public Lines {
+  public:
+    bool finish();
+    void print(std::ostream& stream) const;
+
+  protected:
+    void line(std::string_view line, bool last) override;
+
+  private:
+    void count(const std::string& path, std::size_t size);
+
+    std::vector<std::string> paths;
+    bool dictionary = false;
+    bool valid      = true;
+
+    std::size_t objects    = 0;
+    std::size_t primitives = 0;
+    std::size_t pointers   = 0;
+    std::size_t packed     = 0;
+    std::size_t strings    = 0;
+    std::size_t depth      = 0;
+    std::size_t total      = 0;
+    std::unordered_map<std::string, std::size_t> bytes;
+};
+
+bool Statistics::finish() {
+    flush();
+    return valid && !dictionary && paths.empty() && objects > 0;
+}
+
+void Statistics::print(std::ostream& stream) const {
+    stream << "Objects:    " << objects << '\n';
+    stream << "Primitives: " << primitives << '\n';
+    stream << "Pointers:   " << pointers << '\n';
+    stream << "Packed:     " << packed << '\n';
+    stream << "Strings:    " << strings << " (dictionary)\n";
+    stream << "Depth:      " << depth << '\n';
+    stream << "Bytes:      " << total << "\n\n";
+
+    // Sort paths by size (including children), largest first
+    std::vector<std::pair<std::string, std::size_t>> sorted(bytes.begin(), bytes.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second == b.second ? a.first < b.first : a.second > b.second;
+    });
+
+    stream << "Bytes per field path:\n";
+    for(const auto& [path, size] : sorted) {
+        const double share = total == 0 ? 0.0 : 100.0 * static_cast<double>(size) / static_cast<double>(total);
+        stream << std::setw(14) << size << std::setw(8) << std::fixed << std::setprecision(1) << share << "%  "
+               << path << '\n';
+    }
+}
+
+void Statistics::line(std::string_view line, bool last) {
+    const std::size_t size = last ? line.size() : line.size() + 1;
+    total += size;
+
+    // Dictionary entries
+    if(dictionary) {
+        if(line == "}") dictionary = false;
+        else strings++;
+        count("STRINGS", size);
+        return;
+    }
+    if(paths.empty() && (line == "STRINGS {" || line == "STRINGS{")) {
+        dictionary = true;
+        count("STRINGS", size);
+        return;
+    }
+
+    // Text version
+    if(paths.empty() && objects == 0 && line == serializable::detail::string::VERSION) return;
+
+    // Closing brace of an object
+    line.remove_prefix(std::min(line.find_first_not_of('\t'), line.size()));
+    if(line == "}") {
+        if(paths.empty()) valid = false;
+        else {
+            count(paths.back(), size);
+            paths.pop_back();
+        }
+        return;
+    }
+
+    // Split line
+    const auto parsed = parseLine(line);
+    if(!parsed) {
+        valid = false;
+        return;
+    }
+    const auto [type, name, value] = parsed.value();
+
+    // Collect container elements (named by their index) under a single path
+    const bool element = !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return c >= '0' && c <= '9';
+    });
+    std::string path = paths.empty() ? std::string(name) : paths.back() + (element ? "[]" : "." + std::string(name));
+    if(element && paths.empty()) valid = false;
+
+    // Count node (inline objects are a single line including their children, even the root object)
+    if(type.starts_with("OBJECT<") && value.ends_with('}')) {
+        const auto children = parseInline(value);
+        if(!children) valid = false;
+        else {
+            objects++;
+            primitives += children->size();
+            depth = std::max(depth, paths.size() + 1);
+            count(path, size);
+        }
+        return;
+    }
+    if(type.starts_with("OBJECT<")) {
+        objects++;
+        paths.push_back(std::move(path));
+        depth = std::max(depth, paths.size());
+        count(paths.back(), size);
+        return;
+    }
+
+    if(type.starts_with("PTR<")) pointers++;
+    else if(type.find('<') != std::string_view::npos) packed++;
+    else primitives++;
+    if(paths.empty()) valid = false;
+    else count(path, size);
+}
+
+void Statistics::count(const std::string& path, std::size_t size) {
+    // Count bytes for the path itself and every enclosing object
+    bytes[path] += size;
+    for(const auto& parent : paths)
+        if(parent != path) bytes[parent] += size;
+}
+
+// Layout
+class Layout : public Lines {
+  public:
+    Layout(bool compact, std::function<void(std::string_view)> output);
+
+    bool finish();
+
+  protected:
+    void line(std::string_view line, bool last) override;
+
+  private:
+    void write(bool last);
+
+    bool compact;
+    std::function<void(std::string_view)> output;
+    std::string buffer;
+    std::size_t depth = 0;
+    bool dictionary   = false;
+    bool valid        = true;
+};
+
+Layout::Layout(bool compact, std::function<void(std::string_view)> output)
+    : compact(compact), output(std::move(output)) {}
+
+bool Layout::finish() {
+    flush();
+    return valid && !dictionary && depth == 0;
+}
+
+void Layout::line(std::string_view line, bool last) {
+    // Remove indentation (pretty data is indented by one tab per level)
+    line.remove_prefix(std::min(line.find_first_not_of('\t'), line.size()));
+    buffer.assign(compact ? 0 : depth + (dictionary ? 1 : 0), '\t');
+
+    // Dictionary entries
+    if(dictionary) {
+        if(line == "}") {
+            dictionary = false;
+            buffer.clear();
+        }
+        buffer.append(line);
+        return write(last);
+    }
+    if(depth == 0 && (line == "STRINGS {" || line == "STRINGS{")) {
+        dictionary = true;
+        buffer.append(compact ? "STRINGS{" : "STRINGS {");
+        return write(last);
+    }
+
+    // Text version (the same in both layouts)
+    if(depth == 0 && line == serializable::detail::string::VERSION) {
+        buffer.append(line);
+        return write(last);
+    }
+
+    // Closing brace of an object
+    if(line == "}") {
+        if(depth == 0) valid = false;
+        else depth--;
+        buffer.assign(compact ? 0 : depth, '\t');
+        buffer.append(line);
+        return write(last);
+    }
+
+    // Split line (unknown lines are kept as they are)
+    const auto parsed = parseLine(line);
+    if(!parsed) {
+        valid = false;
+        buffer.append(line);
+        return write(last);
+    }
+    auto [type, name, value] = parsed.value();
+
+    // Pattern: TYPE NAME = VALUE (objects: OBJECT<CLASS> NAME = ADDRESS {, inline objects: ... = ADDRESS { CHILD })
+    buffer.append(type).append(" ").append(name).append(compact ? "=" : " = ");
+    const auto children = type.starts_with("OBJECT<") && value.ends_with('}') ? parseInline(value) : std::nullopt;
+    if(children) {
+        buffer.append(value.substr(0, value.find_first_of(" {"))).append(compact ? "{" : " { ");
+        for(const auto child : children.value()) {
+            const auto parsedChild = parseLine(child);
+            if(!parsedChild) valid = false;
+            else {
+                const auto [childType, childName, childValue] = parsedChild.value();
+                buffer.append(childType).append(" ").append(childName).append(compact ? "=" : " = ");
+                buffer.append(childValue);
+            }
+            buffer.append(compact ? ";" : "; ");
+        }
+        if(!children->empty()) buffer.resize(buffer.size() - (compact ? 1 : 2));
+        buffer.append(compact ? "}" : " }");
+    } else if(type.starts_with("OBJECT<")) {
+        value = value.substr(0, value.find_first_of(" {"));
+        buffer.append(value).append(compact ? "{" : " {");
+        depth++;
+    } else buffer.append(value);
+    write(last);
+}
+
+void Layout::write(bool last) {
+    if(!last) buffer.push_back('\n');
+    output(buffer);
+}
+
+// Commands
+int convert(const std::filesystem::path& input, const std::filesystem::path& output, const Options& options,
+            std::optional<bool> compact) {
+    // Open files
+    std::error_code error;
+    if(std::filesystem::equivalent(input, output, error)) {
+        std::cerr << "Input and output must be different files\n";
+        return 1;
+    }
+    std::ifstream source(input, std::ios::binary);
+    if(!source) {
+        std::cerr << "Could not open " << input << '\n';
+        return 1;
+    }
+    std::ofstream target(output, std::ios::binary);
+    if(!target) {
+        std::cerr << "Could not create " << output << '\n';
+        return 1;
+    }
+
+    // Write blocks (with a header for the format of the input) if they are compressed or checksummed
+    const bool blocks = options.codec || options.checksum != Options::Checksum::NONE;
+    Options::Format format{};
+    std::optional<serializable::detail::frame::BlockWriter> writer;
+    const auto write = [&](std::string_view data) {
+        if(blocks && !writer) {
+            target << serializable::detail::frame::makeHeader(format, serializable::detail::frame::BLOCKS);
+            writer.emplace(target, options);
+        }
+        if(writer) writer->write(data);
+        else target.write(data.data(), static_cast<std::streamsize>(data.size()));
+    };
+
+    // Convert data (changing the layout of text line by line if requested)
+    Result result = Result::OK;
+    if(compact) {
+        bool text = true;
+        Layout layout(compact.value(), write);
+        result = readData(source, options.threads, format, [&](std::string_view data) {
+            text = text && format == Options::Format::TEXT;
+            if(text) layout.consume(data);
+        });
+        if(!text) {
+            std::cerr << "Only the layout of text can be changed\n";
+            return 1;
+        }
+        if(!layout.finish() && result == Result::OK) result = Result::STRUCTURE;
+    } else result = readData(source, options.threads, format, write);
+
+    if(writer && !writer->finish() && result == Result::OK) result = Result::FILE;
+    if(!target && result == Result::OK) result = Result::FILE;
+
+    if(result != Result::OK) {
+        std::cerr << "Conversion failed: " << RESULTS.at(static_cast<std::size_t>(result)) << '\n';
+        return 1;
+    }
+    return 0;
+}
+
+int stats(const std::filesystem::path& input, unsigned int threads) {
+    // Open file
+    std::ifstream source(input, std::ios::binary);
+    if(!source) {
+        std::cerr << "Could not open " << input << '\n';
+        return 1;
+    }
+
+    // Collect statistics
+    bool text = true;
+    Options::Format format{};
+    Statistics statistics;
+    const Result result = readData(source, threads, format, [&](std::string_view data) {
+        text = text && format == Options::Format::TEXT;
+        if(text) statistics.consume(data);
+    });
+    if(!text) {
+        std::cerr << "Statistics are only available for text\n";
+        return 1;
+    }
+    if(result != Result::OK) {
+        std::cerr << "Reading failed: " << RESULTS.at(static_cast<std::size_t>(result)) << '\n';
+        return 1;
+    }
+    if(!statistics.finish()) {
+        std::cerr << "Reading failed: " << RESULTS.at(static_cast<std::size_t>(Result::STRUCTURE)) << '\n';
+        return 1;
+    }
+
+    statistics.print(std::cout);
+    return 0;
+}
+
+// Arguments
+std::optional<std::shared_ptr<const serializable::Codec>> parseCodec(std::string_view name) {
+    if(name == "none") return nullptr;
+    if(name == "lz") return std::make_shared<serializable::LZCodec>();
+#if defined(SERIALIZABLE_ZLIB)
+    if(name == "zlib") return std::make_shared<serializable::ZlibCodec>();
+#endif
+#if defined(SERIALIZABLE_ZSTD)
+    if(name == "zstd") return std::make_shared<serializable::ZstdCodec>();
+#endif
+    return std::nullopt;
+}
+
+std::optional<Options::Checksum> parseChecksum(std::string_view name) {
+    if(name == "none") return Options::Checksum::NONE;
+    if(name == "crc32c") return Options::Checksum::CRC32C;
+    if(name == "xxhash32") return Options::Checksum::XXHASH32;
+    return std::nullopt;
+}
+
+int usage() {
+    std::cerr << "Usage:\n"
+                 "  Tool convert INPUT OUTPUT [OPTIONS]  Converts a save file (text, JSON or MessagePack in any\n"
+                 "                                       encoding) into the given encoding\n"
+                 "  Tool stats INPUT [OPTIONS]           Prints node counts, depth and bytes per field path\n"
+                 "\n"
+                 "Options:\n"
+                 "  --layout keep|pretty|compact         Layout of the text (default: keep)\n"
+                 "  --codec none|lz|zlib|zstd            Compresses blocks (default: none)\n"
+                 "  --checksum none|crc32c|xxhash32      Checksums blocks (default: none)\n"
+                 "  --block-size BYTES                   Size of uncompressed blocks (default: 1048576)\n"
+                 "  --threads COUNT                      Threads compressing blocks (default: 0, one per hardware "
+                 "thread)\n";
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    const std::vector<std::string_view> arguments(argv + 1, argv + argc);
+    if(arguments.empty()) return usage();
+
+    // Split positional arguments and options
+    std::vector<std::string_view> positional;
+    Options options;
+    std::optional<bool> compact;
+    for(std::size_t i = 0; i < arguments.size(); i++) {
+        if(!arguments[i].starts_with("--")) {
+            positional.push_back(arguments[i]);
+            continue;
+        }
+        if(i + 1 >= arguments.size()) return usage();
+
+        const std::string_view option = arguments[i];
+        const std::string value(arguments[++i]);
+        if(option == "--layout") {
+            if(value == "pretty" || value == "compact") compact = value == "compact";
+            else if(value != "keep") return usage();
+        } else if(option == "--codec") {
+            const auto codec = parseCodec(value);
+            if(!codec) return usage();
+            options.codec = codec.value();
+        } else if(option == "--checksum") {
+            const auto checksum = parseChecksum(value);
+            if(!checksum) return usage();
+            options.checksum = checksum.value();
+        } else if(option == "--block-size") {
+            const auto blockSize = serializable::detail::string::deserializePrimitive<unsigned int>(value);
+            if(!blockSize || blockSize.value() == 0) return usage();
+            options.blockSize = blockSize.value();
+        } else if(option == "--threads") {
+            const auto threads = serializable::detail::string::deserializePrimitive<unsigned int>(value);
+            if(!threads) return usage();
+            options.threads = threads.value();
+        } else return usage();
+    }
+
+    // Run command
+    if(positional.size() == 3 && positional[0] == "convert")
+        return convert(positional[1], positional[2], options, compact);
+    if(positional.size() == 2 && positional[0] == "stats") return stats(positional[1], options.threads);
+    return usage();
+}